@@ -28,15 +28,78 @@ struct db_node
 };
 
 /*
- * This structure is used to represent an entire doubly-linked list. Note that
- * we're keeping track of both the head and the tail of the list here.
+ * This structure is used to represent an entire doubly-linked list. The list
+ * is circular around a sentinel node: `sentinel.next` is the head of the list
+ * and `sentinel.prev` is the tail (both are the sentinel itself when the list
+ * is empty). Since every real node always has a real prev and next node,
+ * inserting and unlinking never have to check for the ends of the list.
+ *
+ * Nodes that are removed from the list are not freed right away. They are
+ * kept on `free_nodes`, linked through their `next` pointers, and reused by
+ * later inserts, so a list whose size goes up and down doesn't keep calling
+ * malloc() and free().
  */
 struct db_list
 {
-    struct db_node* head;
-    struct db_node* tail;
+    struct db_node sentinel;
+    struct db_node* free_nodes;
 };
 
+/*
+ * Helper function to get a node for a list, reusing a freed node if there is
+ * one. The node's fields are not initialized.
+ */
+static struct db_node* db_node_alloc(struct db_list* db_list)
+{
+    struct db_node* node = db_list->free_nodes;
+    if (node != NULL) {
+        db_list->free_nodes = node->next;
+        return node;
+    }
+    node = malloc(sizeof(struct db_node));
+    assert(node);
+    return node;
+}
+
+/*
+ * Helper function to link a new node holding `val` in between two adjacent
+ * nodes `prev` and `next` (either of which may be the sentinel).
+ */
+static struct db_node* db_link_between(struct db_list* db_list, void* val,
+    struct db_node* prev, struct db_node* next)
+{
+    struct db_node* node = db_node_alloc(db_list);
+    node->val = val;
+    node->prev = prev;
+    node->next = next;
+    prev->next = node;
+    next->prev = node;
+    return node;
+}
+
+/*
+ * Helper function to unlink a node from its list without freeing it.
+ */
+static void db_unlink(struct db_node* node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+}
+
+/*
+ * Helper function to free every node in a chain linked through `next`
+ * pointers, stopping at `end`.
+ */
+static void db_free_chain(struct db_node* node, struct db_node* end)
+{
+    struct db_node* next;
+    while (node != end) {
+        next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
 /*
  * This function should allocate and initialize a new, empty doubly linked list and
  * return a pointer to it.
@@ -45,10 +108,13 @@ struct db_list
  */
 struct db_list* db_list_create()
 {
-    /*
-     * FIX ME: 
-     */
-    return NULL;
+    struct db_list* db_list = malloc(sizeof(struct db_list));
+    assert(db_list);
+    db_list->sentinel.val = NULL;
+    db_list->sentinel.prev = &db_list->sentinel;
+    db_list->sentinel.next = &db_list->sentinel;
+    db_list->free_nodes = NULL;
+    return db_list;
 }
 
 /*
@@ -64,10 +130,11 @@ struct db_list* db_list_create()
  */
 void db_list_free(struct db_list* db_list)
 {
-    /*
-     * FIX ME: 
-     */
-    return;
+    assert(db_list);
+    // Frees the nodes still in the list, then the ones waiting to be reused
+    db_free_chain(db_list->sentinel.next, &db_list->sentinel);
+    db_free_chain(db_list->free_nodes, NULL);
+    free(db_list);
 }
 
 /*
@@ -85,10 +152,8 @@ void db_list_free(struct db_list* db_list)
  */
 void db_list_insert(struct db_list* db_list, void* val)
 {
-    /*
-     * FIX ME: 
-     */
-    return;
+    assert(db_list);
+    db_link_between(db_list, val, &db_list->sentinel, db_list->sentinel.next);
 }
 
 /*
@@ -106,11 +171,9 @@ void db_list_insert(struct db_list* db_list, void* val)
  */
 void db_list_insert_end(struct db_list* db_list, void* val)
 {
-    /* Hint: use the 'tail' pointer instead of iterating through the whole list */
-    /*
-     * FIX ME: 
-     */
-    return;
+    assert(db_list);
+    // The tail is the node before the sentinel, so no need to walk the list
+    db_link_between(db_list, val, db_list->sentinel.prev, &db_list->sentinel);
 }
 
 
@@ -120,6 +183,9 @@ void db_list_insert_end(struct db_list* db_list, void* val)
  * Importantly, this function will also need to free the
  * memory held by the node being removed (it does not need to free the stored
  * value itself, just the node).
+ *
+ * Here the removed node is kept on the list's free list to be reused, and is
+ * freed by db_list_free().
 
  * Params:
  * db_list - the doubly-linked list from which to remove an element. May not be NULL.
@@ -127,11 +193,10 @@ void db_list_insert_end(struct db_list* db_list, void* val)
  */
 void db_list_remove_end(struct db_list* db_list)
 {
-	/* Hint: use the 'tail' pointer instead of iterating through the whole list */
-	/*
-     * FIX ME: 
-     */
-    return;
+    assert(db_list);
+    if (db_list->sentinel.prev != &db_list->sentinel) {
+        db_list_remove_node(db_list, db_list->sentinel.prev);
+    }
 }
 
 
@@ -154,10 +219,11 @@ void db_list_remove_end(struct db_list* db_list)
  */
 void db_list_display_forward(struct db_list* db_list, void (*p)(void* a))
 {
-	/*
-     * FIX ME: 
-     */
-	return;
+    assert(db_list);
+    struct db_node* node;
+    for (node = db_list->sentinel.next; node != &db_list->sentinel; node = node->next) {
+        p(node->val);
+    }
 }
 
 /*
@@ -179,9 +245,90 @@ void db_list_display_forward(struct db_list* db_list, void (*p)(void* a))
  */
 void db_list_display_backward(struct db_list* db_list, void (*p)(void* a))
 {
-	/*
-     * FIX ME: 
-     */
-	return;
+    assert(db_list);
+    struct db_node* node;
+    for (node = db_list->sentinel.prev; node != &db_list->sentinel; node = node->prev) {
+        p(node->val);
+    }
+}
+
+/*
+ * These functions return a handle to the node at the head or the tail of a
+ * given doubly-linked list, or NULL if the list is empty. Right after
+ * db_list_insert() or db_list_insert_end(), this is the node that was just
+ * inserted. A handle stays valid until its node is removed from the list.
+ *
+ * Params:
+ * db_list - the doubly-linked list to look at. May not be NULL.
+ */
+struct db_node* db_list_head_node(struct db_list* db_list)
+{
+    assert(db_list);
+    if (db_list->sentinel.next == &db_list->sentinel) {
+        return NULL;
+    }
+    return db_list->sentinel.next;
+}
+
+struct db_node* db_list_tail_node(struct db_list* db_list)
+{
+    assert(db_list);
+    if (db_list->sentinel.prev == &db_list->sentinel) {
+        return NULL;
+    }
+    return db_list->sentinel.prev;
+}
+
+/*
+ * This function returns the value stored in the node with a given handle.
+ *
+ * Params:
+ * node - a handle to a node in a doubly-linked list. May not be NULL.
+ */
+void* db_list_node_val(struct db_node* node)
+{
+    assert(node);
+    return node->val;
+}
+
+/*
+ * This function removes the node with a given handle from a doubly-linked
+ * list in O(1) time, wherever it is in the list. The handle is no longer
+ * valid afterwards (the node is kept to be reused by a later insert).
+ *
+ * Params:
+ * db_list - the doubly-linked list from which to remove the node. May not be
+ *     NULL.
+ * node - a handle to the node to remove. May not be NULL, and must be a node
+ *     in `db_list`.
+ */
+void db_list_remove_node(struct db_list* db_list, struct db_node* node)
+{
+    assert(db_list && node);
+    assert(node != &db_list->sentinel);
+    db_unlink(node);
+    node->next = db_list->free_nodes;
+    db_list->free_nodes = node;
+}
+
+/*
+ * This function moves the node with a given handle to the head of a
+ * doubly-linked list in O(1) time. The handle stays valid. This is the
+ * operation a cache or scheduler uses to mark an entry as most recently used.
+ *
+ * Params:
+ * db_list - the doubly-linked list containing the node. May not be NULL.
+ * node - a handle to the node to move. May not be NULL, and must be a node
+ *     in `db_list`.
+ */
+void db_list_move_to_front(struct db_list* db_list, struct db_node* node)
+{
+    assert(db_list && node);
+    assert(node != &db_list->sentinel);
+    db_unlink(node);
+    node->prev = &db_list->sentinel;
+    node->next = db_list->sentinel.next;
+    node->next->prev = node;
+    db_list->sentinel.next = node;
 }
 
@@ -30,5 +30,11 @@ void db_list_remove_end(struct db_list* db_list);
 void db_list_display_forward(struct db_list* db_list, void (*p)(void* a));
 void db_list_display_backward(struct db_list* db_list, void (*p)(void* a));
 
+struct db_node* db_list_head_node(struct db_list* db_list);
+struct db_node* db_list_tail_node(struct db_list* db_list);
+void* db_list_node_val(struct db_node* node);
+void db_list_remove_node(struct db_list* db_list, struct db_node* node);
+void db_list_move_to_front(struct db_list* db_list, struct db_node* node);
+
 
 #endif
@@ -17,6 +17,7 @@
 void test_db_list(struct student** students, int n) 
 {
     struct db_list* db_list;
+    struct db_node** nodes;
     struct student* s;
     int i, p;
 
@@ -83,6 +84,7 @@ void test_db_list(struct student** students, int n)
 
 
     db_list = db_list_create();
+    nodes = malloc(n * sizeof(struct db_node*));
 
     printf("\nAdding more elements back....\n");
     /*
@@ -93,6 +95,7 @@ void test_db_list(struct student** students, int n)
         printf("Adding students[%d] to the end of the doubly-linked list... ", i);
         fflush(stdout);
         db_list_insert_end(db_list, students[i]);
+        nodes[i] = db_list_tail_node(db_list);
         printf("OK (check for correct positions below)\n");
     }
 
@@ -135,7 +138,37 @@ void test_db_list(struct student** students, int n)
     printf("\n");
     printf("Actual:\n");
     db_list_display_backward(db_list, &print_student);
-    
+
+
+    /*
+     * Test moving and removing nodes in the middle of the list by handle.
+     */
+    printf("\nMoving students[%d] to the front and removing students[1]... ", n/2);
+    fflush(stdout);
+    db_list_move_to_front(db_list, nodes[n/2]);
+    db_list_remove_node(db_list, nodes[1]);
+    if (db_list_head_node(db_list) == nodes[n/2]
+            && db_list_node_val(db_list_tail_node(db_list)) == students[n/2 - 1])
+        printf("OK\n");
+    else
+        printf("FAILED\n");
+
+    printf("\n");
+    printf("Display the doubly-linked list forward...\n");
+
+    printf("Expected:\n");
+    print_student((void*)students[n/2]);
+    for (i = 0; i < n/2; ++i)
+    {
+        if (i != 1)
+            print_student((void*)students[i]);
+    }
+
+    printf("\n");
+    printf("Actual:\n");
+    db_list_display_forward(db_list, &print_student);
+    free(nodes);
+
 
     printf("\nFreeing doubly-linked list again... ");
     fflush(stdout);
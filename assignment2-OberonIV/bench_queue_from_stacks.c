@@ -0,0 +1,99 @@
+/*
+ * This file contains executable code to compare the latency of individual
+ * operations on the queue-from-stacks and the real-time queue-from-stacks.
+ * Each queue is kept at a steady size (first 1000 values, then 1000000)
+ * while enqueues and dequeues alternate, and every operation is timed
+ * separately.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "queue_from_stacks.h"
+#include "queue_from_stacks_rt.h"
+
+#define MAX_QUEUE_SIZE 1000000
+#define NUM_OPS 4000000
+
+long now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+int compare_long(const void* a, const void* b) {
+  long x = *(const long*)a, y = *(const long*)b;
+  return (x > y) - (x < y);
+}
+
+/*
+ * Prints the mean and the tail of the `n` latencies in `times`.
+ */
+void report(const char* name, int size, long* times, int n) {
+  double total = 0;
+  int i;
+  for (i = 0; i < n; i++) {
+    total += times[i];
+  }
+  qsort(times, n, sizeof(long), compare_long);
+  printf("%-20s %8d %8.0f %8ld %8ld %8ld %10ld\n", name, size, total / n,
+    times[n / 2], times[(int)(n * 0.999)], times[(int)(n * 0.99999)],
+    times[n - 1]);
+}
+
+/*
+ * Times NUM_OPS alternating enqueues and dequeues on each kind of
+ * queue-from-stacks, starting with `size` values in the queue.
+ */
+void measure(long* times, int size) {
+  struct queue_from_stacks* q = queue_from_stacks_create();
+  struct queue_from_stacks_rt* rt = queue_from_stacks_rt_create();
+  int val, i;
+
+  for (i = 0; i < size; i++) {
+    queue_from_stacks_enqueue(q, &val);
+    queue_from_stacks_rt_enqueue(rt, &val);
+  }
+
+  for (i = 0; i < NUM_OPS; i++) {
+    long start = now_ns();
+    if (i % 2) {
+      queue_from_stacks_dequeue(q);
+    } else {
+      queue_from_stacks_enqueue(q, &val);
+    }
+    times[i] = now_ns() - start;
+  }
+  report("queue_from_stacks", size, times, NUM_OPS);
+
+  for (i = 0; i < NUM_OPS; i++) {
+    long start = now_ns();
+    if (i % 2) {
+      queue_from_stacks_rt_dequeue(rt);
+    } else {
+      queue_from_stacks_rt_enqueue(rt, &val);
+    }
+    times[i] = now_ns() - start;
+  }
+  report("queue_from_stacks_rt", size, times, NUM_OPS);
+
+  queue_from_stacks_free(q);
+  queue_from_stacks_rt_free(rt);
+}
+
+int main(int argc, char** argv) {
+  long* times = malloc(NUM_OPS * sizeof(long));
+  int size;
+
+  printf("%-20s %8s %8s %8s %8s %8s %10s\n", "latency (ns)", "size", "mean",
+    "p50", "p99.9", "p99.999", "max");
+  for (size = 1000; size <= MAX_QUEUE_SIZE; size *= 1000) {
+    measure(times, size);
+  }
+
+  free(times);
+  return 0;
+}
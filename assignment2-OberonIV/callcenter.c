@@ -2,8 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "queue.h"
-#include "stack.h"
+#include "ilist.h"
 
 
 /*
@@ -14,48 +13,36 @@ struct call {
 	int id;
 	char name[100];
 	char reason[100];
+	// Links the call into the queue or the stack; a call is only ever in one of them,
+	// so one link is enough and neither needs to allocate a node for it
+	struct ilist_link link;
 };
 
-struct stack{
-	// Defines the stack struct
-	struct list* list;
-};
+// Returns the call a link belongs to, or NULL for a NULL link
+static struct call* call_of(struct ilist_link* link){
+	return link ? ILIST_ENTRY(link, struct call, link) : NULL;
+}
 
-struct queue{
-	// Defines the queue struct
-	struct dynarray* array;
-};
-void init_call_center(struct stack** call_stack,struct queue** call_queue){
-	// Initilizes the stack and queue using the respective create functions
-	*call_stack = stack_create();
-	*call_queue = queue_create();
+void init_call_center(struct ilist* call_stack, struct ilist* call_queue){
+	// Initilizes the stack and queue as empty intrusive lists
+	ilist_init(call_stack);
+	ilist_init(call_queue);
 }
 
-void free_call_center(struct stack** call_stack, struct queue** call_queue){
+void free_call_center(struct ilist* call_stack, struct ilist* call_queue){
 	// Logic to free stack when the stack isnt empty
-	while(!stack_isempty(*call_stack)){
-		// Uses stack_pop to set the top of the array to call
-		struct call* call = (struct call*)stack_pop(*call_stack);
-		// If call isnt null, frees call
-		if(call != NULL){
-			free(call);
-		}
+	while(!ilist_isempty(call_stack)){
+		// Pops the top of the stack and frees the call
+		free(call_of(ilist_remove_head(call_stack)));
 	}
 	// Logic to free queue when the queue isnt empty
-	while(!queue_isempty(*call_queue)){
-		// Uses dequeue to set the front of the queue to call
-		struct call* call = (struct call*)queue_dequeue(*call_queue);
-		// If call isnt null, frees call
-		if(call != NULL){
-			free(call);
-		}
+	while(!ilist_isempty(call_queue)){
+		// Dequeues the front of the queue and frees the call
+		free(call_of(ilist_remove_head(call_queue)));
 	}
-	// Frees the stack and queue initilizes in init_call_center
-	stack_free(*call_stack);
-	queue_free(*call_queue);
 }
 
-void receive_call(struct stack* call_stack, struct queue* call_queue, int* size, int* queue_size){
+void receive_call(struct ilist* call_stack, struct ilist* call_queue, int* size, int* queue_size){
 	// Allocates memory for call
 	struct call* call = malloc(sizeof(struct call));
 	// Reads data from the user of call details
@@ -63,8 +50,8 @@ void receive_call(struct stack* call_stack, struct queue* call_queue, int* size,
 	scanf("%s", call->name);
 	printf("Enter caller's reason: \n");
 	scanf("%s", call->reason);
-	// Uses enqueue to add the call to the queue
-	queue_enqueue(call_queue, call);
+	// Adds the call to the back of the queue
+	ilist_insert_end(call_queue, &call->link);
 	printf("The call has been successfully added to the queue!\n");
 	// Sets the call ID +1 of the previous call, initalizes in main() as 0
 	call->id = *size + 1;
@@ -74,16 +61,16 @@ void receive_call(struct stack* call_stack, struct queue* call_queue, int* size,
 	(*queue_size)++;
 }
 
-void answer_call(struct stack* call_stack, struct queue* call_queue, int* call_size, int* queue_size){
+void answer_call(struct ilist* call_stack, struct ilist* call_queue, int* call_size, int* queue_size){
 	// Checks if the queue is empty, returns
 	if(*queue_size == 0){
 		printf("No more calls need to be answered at the moment!\n");
 		return;
 	}
 	// Dequeues the queue, setting call as the front of the queue
-	struct call* call = (struct call*)queue_dequeue(call_queue);
+	struct call* call = call_of(ilist_remove_head(call_queue));
 	// Adds the deqeued call to the top of the stack
-	stack_push(call_stack, call);
+	ilist_insert(call_stack, &call->link);
 	// Print the values of call, or the front of the queue, the value of the call answered
 	printf("The following call has been answered and added to the stack!\n");
 	printf("Caller's ID: %d \n", call->id);
@@ -95,13 +82,11 @@ void answer_call(struct stack* call_stack, struct queue* call_queue, int* call_s
 	(*queue_size)--;
 }
 
-void print_stack(struct stack* call_stack, struct queue* call_queue, int* call_size){
+void print_stack(struct ilist* call_stack, struct ilist* call_queue, int* call_size){
 	// Returns call size, or the amount of calls taken
 	printf("Number of calls answered: %d \n", *call_size);
-	// Uses the stack_top function to get the top of the stack
-	void* top = stack_top(call_stack);
 	// Sets call as the top of the stack, which is the last call dequeued, and the latest call taken
-	struct call* call = (struct call*)top;
+	struct call* call = call_of(ilist_head(call_stack));
 	// Checks if call is empty, returns
 	if(call == NULL){
 		printf("No calls have been answered!\n");
@@ -114,17 +99,15 @@ void print_stack(struct stack* call_stack, struct queue* call_queue, int* call_s
 	printf("Caller's reason: %s \n", call->reason);
 }
 
-void print_queue(struct stack* call_stack, struct queue* call_queue, int* call_size, int* queue_size){
+void print_queue(struct ilist* call_stack, struct ilist* call_queue, int* call_size, int* queue_size){
 	// Returns the queue siz
 	printf("Number of calls to be answered: %d \n", *queue_size);
 	// Checks if queue is empty, returns
 	if(*queue_size == 0){
 		return;
 	}
-	// Uses queue_front to get the top of the queue
-	void* front = queue_front(call_queue);
 	// Sets call as the front of the queue, or the next call that will be answered
-	struct call* call = (struct call*)front;
+	struct call* call = call_of(ilist_head(call_queue));
 	// Checks if there are no more calls, returns
 	if(call == NULL){
 		printf("No calls have been answered!\n");
@@ -146,11 +129,11 @@ int main(int argc, char *argv[]) {
 	// This variable keeps track of the size of the queue, can increase or decrease based on user calls
 	int queue_size = 0;
 	// Defines call_stack and call_queue
-	struct stack* call_stack;
-	struct queue* call_queue;
+	struct ilist call_stack;
+	struct ilist call_queue;
 	int choice;
 	// Calls init_call_center, initlizing the stack and queue
-	init_call_center(&call_stack,&call_queue);
+	init_call_center(&call_stack, &call_queue);
 	// Switch case for each option presented
 	do{
 		printf("1. Receive a new call\n");
@@ -162,16 +145,16 @@ int main(int argc, char *argv[]) {
 		scanf("%d", &choice);
 		switch(choice){
 			case 1:
-				receive_call(call_stack, call_queue, &size, &queue_size);
+				receive_call(&call_stack, &call_queue, &size, &queue_size);
 				break;
 			case 2:
-				answer_call(call_stack, call_queue, &call_size, &queue_size);
+				answer_call(&call_stack, &call_queue, &call_size, &queue_size);
 				break;
 			case 3:
-				print_stack(call_stack, call_queue, &call_size);
+				print_stack(&call_stack, &call_queue, &call_size);
 				break;
 			case 4:
-				print_queue(call_stack, call_queue, &call_size, &queue_size);
+				print_queue(&call_stack, &call_queue, &call_size, &queue_size);
 				break;
 			case 5:
 				printf("Thank you! Have a nice day!");
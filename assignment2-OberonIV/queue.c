@@ -120,14 +120,82 @@ void* queue_dequeue(struct queue* queue) {
 	if(queue == NULL){
 		return NULL;
 	}
-	// Checks the value at the start of the array using queue_front
-	void* front = queue_front(queue);
-	// Remoes the value at the start of the array using dynarray_remove
-	dynarray_remove(queue->array, 0);
-	// Returns the value at the start of the array, the value that was removed
-	return front;
+	// Removes the value at the start of the array using dynarray_remove_front,
+	// which just advances the head of the circular buffer, and returns it
+	return dynarray_remove_front(queue->array);
 }
 
+/*
+ * This function enqueues `n` values into a given queue at once, in order, so
+ * that vals[0] is the first of them to be dequeued.  The values are copied
+ * into the queue's storage with at most two memcpy()s.
+ *
+ * Params:
+ *   queue - the queue into which the values are to be enqueued.  If NULL,
+ *     nothing is enqueued.
+ *   vals - the values to be enqueued.  May be NULL only if `n` is 0.
+ *   n - the number of values in `vals`.
+ */
+void queue_enqueue_n(struct queue* queue, void** vals, int n) {
+	if(queue == NULL){
+		return;
+	}
+	// Uses dynarray_append_n to copy all of the values to the end of the array
+	dynarray_append_n(queue->array, vals, n);
+	return;
+}
+
+/*
+ * This function dequeues up to `max` values from a given queue at once,
+ * copying them in order into `vals`.  The values are copied out of the
+ * queue's storage with at most two memcpy()s.
+ *
+ * Params:
+ *   queue - the queue from which values are to be dequeued.  If NULL, no
+ *     values are dequeued.
+ *   vals - the array into which to copy the dequeued values.  Must have room
+ *     for `max` values.
+ *   max - the most values to dequeue.
+ *
+ * Return:
+ *   This function returns the number of values dequeued, which is less than
+ *   `max` if the queue held fewer values than that.
+ */
+int queue_dequeue_n(struct queue* queue, void** vals, int max) {
+	if(queue == NULL){
+		return 0;
+	}
+	// Uses dynarray_remove_front_n, which copies the values out and advances
+	// the head of the circular buffer past them
+	return dynarray_remove_front_n(queue->array, vals, max);
+}
+
+/*
+ * This function dequeues every value in a given queue in one call.  Rather
+ * than copying the values, it hands over the queue's whole dynamic array
+ * and gives the queue a new, empty one, so this takes O(1) time no matter
+ * how many values are queued.
+ *
+ * The values come back in a `struct dynarray`, so callers need to include
+ * dynarray.h to read them, e.g. with dynarray_size() and dynarray_get().
+ *
+ * Params:
+ *   queue - the queue to be drained.  If NULL, nothing is drained.
+ *
+ * Return:
+ *   This function returns a dynamic array holding the dequeued values in
+ *   order, with the front of the queue at index 0, or NULL if `queue` is
+ *   NULL.  The caller is responsible for freeing it with dynarray_free().
+ */
+struct dynarray* queue_drain(struct queue* queue) {
+	if(queue == NULL){
+		return NULL;
+	}
+	// Takes the array holding the values and replaces it with an empty one
+	struct dynarray* drained = queue->array;
+	queue->array = dynarray_create();
+	return drained;
+}
 
 /*
  * helper function for testing, do not modify
@@ -13,6 +13,12 @@
  */
 struct queue;
 
+/*
+ * Structure used to represent a dynamic array, which queue_drain() hands the
+ * queue's values back in.  Include dynarray.h to use the array it returns.
+ */
+struct dynarray;
+
 /*
  * Queue interface function prototypes.  Refer to queue.c for documentation
  * about each of these functions.
@@ -23,6 +29,9 @@ int queue_isempty(struct queue* queue);
 void queue_enqueue(struct queue* queue, void* val);
 void* queue_front(struct queue* queue);
 void* queue_dequeue(struct queue* queue);
+void queue_enqueue_n(struct queue* queue, void** vals, int n);
+int queue_dequeue_n(struct queue* queue, void** vals, int max);
+struct dynarray* queue_drain(struct queue* queue);
 
 /*
  * helper function for testing
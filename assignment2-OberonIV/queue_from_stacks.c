@@ -34,9 +34,10 @@ struct queue_from_stacks {
 struct queue_from_stacks* queue_from_stacks_create() {
 	// Allocates memory for both stacks
   	struct queue_from_stacks* qfs = malloc(sizeof(struct queue_from_stacks));
-	// Initalizes stacks using stack_create
-	qfs->s1 = stack_create();
-	qfs->s2 = stack_create();
+	// Initalizes stacks using stack_create_backend, with array-backed stacks so
+	// enqueueing and moving values between the stacks don't allocate
+	qfs->s1 = stack_create_backend(STACK_ARRAY);
+	qfs->s2 = stack_create_backend(STACK_ARRAY);
   	return qfs;
 }
 
@@ -0,0 +1,325 @@
+/*
+ * This file contains an implementation of a real-time queue-from-stacks,
+ * after Hood and Melville.  The queue in queue_from_stacks.c moves its whole
+ * inbox into its outbox when the outbox runs out, so while its operations
+ * take O(1) time on average, a single dequeue can take O(n).  This queue
+ * instead starts rebuilding its outbox well before it runs out, and does a
+ * few steps of the rebuilding during every operation, so no operation ever
+ * does more than a constant amount of work moving values between stacks.
+ *
+ * Normally, the queue has a front stack (`front`, whose top is the front of
+ * the queue), an exact copy of it (`front_copy`) and a back stack (`back`,
+ * whose top is the back of the queue).  Enqueues push onto `back`, and
+ * dequeues pop from both `front` and `front_copy`.  As soon as `back` holds
+ * more values than `front`, the queue starts "recopying": it builds a new
+ * front stack holding the values of `front` on top of the values of `back`
+ * in reverse, in two phases:
+ *
+ *   1. Each step moves one value from `front` onto `rev_front` (reversing
+ *      the front) and one value from `back` onto `new_front` (reversing the
+ *      back, so the oldest value in it ends up on top).
+ *
+ *   2. Each step moves one value from `rev_front` back onto `new_front`, on
+ *      top of the reversed back, putting the front values back in order.
+ *
+ * While this goes on, enqueues push onto `new_back`, and dequeues pop from
+ * `front_copy`, which still holds the front values in order.  A value that
+ * is dequeued during recopying doesn't need to be moved onto `new_front`, so
+ * `live` counts the front values that have neither been dequeued nor moved
+ * yet, and phase 2 stops when it reaches 0; since dequeues take values from
+ * the front and phase 2 moves them from the back, the values still in
+ * `rev_front` at that point are exactly the ones that were dequeued.  Every
+ * value pushed onto `new_front` is also pushed onto `new_front_copy`, so
+ * when recopying finishes, the new front stack has a copy, and the new
+ * stacks replace the old ones.
+ *
+ * Recopying starts when `back` has n + 1 values and `front` has n, so it
+ * takes at most 2n + 1 steps, and `front_copy` runs out after n dequeues.
+ * Doing RT_STEPS = 3 steps per operation therefore always finishes
+ * recopying before a dequeue would need a value that isn't in `front_copy`.
+ *
+ * When recopying finishes, the values left over in `rev_front` and the old
+ * `front_copy` (which becomes `new_front_copy`) are garbage.  Rather than
+ * discarding all of them at once, every operation after that pops up to
+ * RT_STEPS of them.  If the old front stack had n values, there are n
+ * leftover values, and the new front stack is at least n + 1 values bigger
+ * than the back stack after the at most (2n + 3) / 3 operations recopying
+ * took, so recopying can't start again until at least (4n + 3) / 3
+ * operations later; by then, the leftovers are long gone.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "stack.h"
+#include "queue_from_stacks_rt.h"
+
+/*
+ * The number of recopying steps done during each operation.
+ */
+#define RT_STEPS 3
+
+/*
+ * This is the structure that represents a real-time queue-from-stacks.  See
+ * the description above for the roles of the stacks.  `size` is the number
+ * of values in the queue, and `recopying` is 1 while recopying is under way.
+ * `work` counts the values the last operation pushed onto or popped off of
+ * the stacks.
+ */
+struct queue_from_stacks_rt {
+  struct stack* front;
+  struct stack* front_copy;
+  struct stack* back;
+  struct stack* rev_front;
+  struct stack* new_front;
+  struct stack* new_front_copy;
+  struct stack* new_back;
+  int recopying;
+  int live;
+  int size;
+  int work;
+};
+
+/*
+ * This function allocates and initializes a new, empty real-time
+ * queue-from-stacks and returns a pointer to it.
+ */
+struct queue_from_stacks_rt* queue_from_stacks_rt_create() {
+  struct queue_from_stacks_rt* qfs =
+    malloc(sizeof(struct queue_from_stacks_rt));
+  assert(qfs);
+  qfs->front = stack_create_backend(STACK_ARRAY);
+  qfs->front_copy = stack_create_backend(STACK_ARRAY);
+  qfs->back = stack_create_backend(STACK_ARRAY);
+  qfs->rev_front = stack_create_backend(STACK_ARRAY);
+  qfs->new_front = stack_create_backend(STACK_ARRAY);
+  qfs->new_front_copy = stack_create_backend(STACK_ARRAY);
+  qfs->new_back = stack_create_backend(STACK_ARRAY);
+  qfs->recopying = 0;
+  qfs->live = 0;
+  qfs->size = 0;
+  qfs->work = 0;
+  return qfs;
+}
+
+/*
+ * This function frees the memory associated with a real-time
+ * queue-from-stacks.  Note that it does not free any memory allocated to the
+ * pointer values stored in the queue.  This is the responsibility of the
+ * caller.
+ *
+ * Params:
+ *   qfs - the real-time queue-from-stacks to be destroyed.  May not be NULL.
+ */
+void queue_from_stacks_rt_free(struct queue_from_stacks_rt* qfs) {
+  assert(qfs);
+  stack_free(qfs->front);
+  stack_free(qfs->front_copy);
+  stack_free(qfs->back);
+  stack_free(qfs->rev_front);
+  stack_free(qfs->new_front);
+  stack_free(qfs->new_front_copy);
+  stack_free(qfs->new_back);
+  free(qfs);
+}
+
+/*
+ * This function indicates whether a given real-time queue-from-stacks is
+ * currently empty.  It returns 1 if the specified queue is empty (i.e.
+ * contains no elements) and 0 otherwise.
+ *
+ * Params:
+ *   qfs - the real-time queue-from-stacks whose emptiness is being
+ *     questioned.  May not be NULL.
+ */
+int queue_from_stacks_rt_isempty(struct queue_from_stacks_rt* qfs) {
+  assert(qfs);
+  return qfs->size == 0;
+}
+
+/*
+ * Auxilliary function to swap two stack pointers.
+ */
+static void _rt_swap(struct stack** a, struct stack** b) {
+  struct stack* tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+/*
+ * Auxilliary functions to push a value onto or pop a value off of one of the
+ * stacks, counting it in `work`.
+ */
+static void _rt_push(struct queue_from_stacks_rt* qfs, struct stack* stack,
+    void* val) {
+  stack_push(stack, val);
+  qfs->work++;
+}
+
+static void* _rt_pop(struct queue_from_stacks_rt* qfs, struct stack* stack) {
+  qfs->work++;
+  return stack_pop(stack);
+}
+
+/*
+ * Auxilliary function to finish recopying: the new stacks replace the old
+ * ones, and the old ones are kept to be the new stacks the next time the
+ * queue recopies.  The old `front` and `back` are already empty, and the
+ * values left in `rev_front` and the old `front_copy` are discarded a few at
+ * a time by _rt_discard().
+ */
+static void _rt_finish(struct queue_from_stacks_rt* qfs) {
+  _rt_swap(&qfs->front, &qfs->new_front);
+  _rt_swap(&qfs->front_copy, &qfs->new_front_copy);
+  _rt_swap(&qfs->back, &qfs->new_back);
+  qfs->recopying = 0;
+}
+
+/*
+ * Auxilliary function to do up to `steps` steps of recopying, finishing it
+ * if they are enough.
+ */
+static void _rt_step(struct queue_from_stacks_rt* qfs, int steps) {
+  for (int i = 0; qfs->recopying && i < steps; i++) {
+    if (!stack_isempty(qfs->front) || !stack_isempty(qfs->back)) {
+      if (!stack_isempty(qfs->front)) {
+        _rt_push(qfs, qfs->rev_front, _rt_pop(qfs, qfs->front));
+      }
+      if (!stack_isempty(qfs->back)) {
+        void* val = _rt_pop(qfs, qfs->back);
+        _rt_push(qfs, qfs->new_front, val);
+        _rt_push(qfs, qfs->new_front_copy, val);
+      }
+    } else if (qfs->live > 0) {
+      void* val = _rt_pop(qfs, qfs->rev_front);
+      _rt_push(qfs, qfs->new_front, val);
+      _rt_push(qfs, qfs->new_front_copy, val);
+      qfs->live--;
+    }
+
+    if (stack_isempty(qfs->front) && stack_isempty(qfs->back)
+        && qfs->live == 0) {
+      _rt_finish(qfs);
+    }
+  }
+}
+
+/*
+ * Auxilliary function to discard up to `steps` of the values left over from
+ * the last recopying.
+ */
+static void _rt_discard(struct queue_from_stacks_rt* qfs, int steps) {
+  for (int i = 0; i < steps; i++) {
+    if (!stack_isempty(qfs->rev_front)) {
+      _rt_pop(qfs, qfs->rev_front);
+    } else if (!stack_isempty(qfs->new_front_copy)) {
+      _rt_pop(qfs, qfs->new_front_copy);
+    } else {
+      break;
+    }
+  }
+}
+
+/*
+ * Auxilliary function, called at the end of every operation, to do this
+ * operation's share of recopying, or of discarding the values left over
+ * from the last recopying, and to start recopying if the back stack has
+ * grown bigger than the front stack.
+ */
+static void _rt_maintain(struct queue_from_stacks_rt* qfs) {
+  if (!qfs->recopying) {
+    _rt_discard(qfs, RT_STEPS);
+  }
+  if (!qfs->recopying
+      && stack_size(qfs->back) > stack_size(qfs->front)) {
+    assert(stack_isempty(qfs->rev_front)
+        && stack_isempty(qfs->new_front_copy));
+    qfs->recopying = 1;
+    qfs->live = stack_size(qfs->front);
+  }
+  _rt_step(qfs, RT_STEPS);
+}
+
+/*
+ * This function enqueues a new value into a given real-time
+ * queue-from-stacks.  The value to be enqueued is specified as a void
+ * pointer.
+ *
+ * Params:
+ *   qfs - the real-time queue-from-stacks into which a value is to be
+ *     enqueued.  May not be NULL.
+ *   val - the value to be enqueued.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void queue_from_stacks_rt_enqueue(struct queue_from_stacks_rt* qfs,
+    void* val) {
+  assert(qfs);
+  qfs->work = 0;
+  _rt_push(qfs, qfs->recopying ? qfs->new_back : qfs->back, val);
+  qfs->size++;
+  _rt_maintain(qfs);
+}
+
+/*
+ * This function returns the value stored at the front of a given real-time
+ * queue-from-stacks *without* removing that value, or NULL if the queue is
+ * empty.
+ *
+ * Params:
+ *   qfs - the real-time queue-from-stacks from which to query the front
+ *     value.  May not be NULL.
+ */
+void* queue_from_stacks_rt_front(struct queue_from_stacks_rt* qfs) {
+  assert(qfs);
+  return stack_top(qfs->recopying ? qfs->front_copy : qfs->front);
+}
+
+/*
+ * This function dequeues a value from a given real-time queue-from-stacks
+ * and returns the dequeued value, or returns NULL if the queue is empty.
+ *
+ * Params:
+ *   qfs - the real-time queue-from-stacks from which a value is to be
+ *     dequeued.  May not be NULL.
+ *
+ * Return:
+ *   This function returns the value that was dequeued.
+ */
+void* queue_from_stacks_rt_dequeue(struct queue_from_stacks_rt* qfs) {
+  assert(qfs);
+  qfs->work = 0;
+  if (qfs->size == 0) {
+    return NULL;
+  }
+
+  void* val;
+  if (qfs->recopying) {
+    assert(!stack_isempty(qfs->front_copy));
+    val = _rt_pop(qfs, qfs->front_copy);
+    qfs->live--;
+  } else {
+    val = _rt_pop(qfs, qfs->front);
+    _rt_pop(qfs, qfs->front_copy);
+  }
+  qfs->size--;
+  _rt_maintain(qfs);
+  return val;
+}
+
+/*
+ * helper function for testing
+ */
+
+/*
+ * This function returns the number of values the last enqueue or dequeue on
+ * a given real-time queue-from-stacks pushed onto or popped off of its
+ * stacks, including values it discarded.  This never exceeds a constant, no
+ * matter how many values are in the queue.
+ *
+ * Params:
+ *   qfs - the real-time queue-from-stacks to query.  May not be NULL.
+ */
+int queue_from_stacks_rt_work(struct queue_from_stacks_rt* qfs) {
+  assert(qfs);
+  return qfs->work;
+}
@@ -0,0 +1,34 @@
+/*
+ * This file contains the definition of the interface for a real-time
+ * queue-from-stacks: a queue built from stacks, like the one in
+ * queue_from_stacks.h, but in which every operation does a bounded amount of
+ * work.  You can find descriptions of the real-time queue-from-stacks
+ * functions, including their parameters and their return values, in
+ * queue_from_stacks_rt.c.
+ */
+
+#ifndef __QUEUE_FROM_STACKS_RT_H
+#define __QUEUE_FROM_STACKS_RT_H
+
+/*
+ * Structure used to represent a real-time queue-from-stacks.
+ */
+struct queue_from_stacks_rt;
+
+/*
+ * Real-time queue-from-stacks interface function prototypes.  Refer to
+ * queue_from_stacks_rt.c for documentation about each of these functions.
+ */
+struct queue_from_stacks_rt* queue_from_stacks_rt_create();
+void queue_from_stacks_rt_free(struct queue_from_stacks_rt* qfs);
+int queue_from_stacks_rt_isempty(struct queue_from_stacks_rt* qfs);
+void queue_from_stacks_rt_enqueue(struct queue_from_stacks_rt* qfs, void* val);
+void* queue_from_stacks_rt_front(struct queue_from_stacks_rt* qfs);
+void* queue_from_stacks_rt_dequeue(struct queue_from_stacks_rt* qfs);
+
+/*
+ * helper function for testing
+ */
+int queue_from_stacks_rt_work(struct queue_from_stacks_rt* qfs);
+
+#endif
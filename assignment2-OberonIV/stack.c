@@ -10,30 +10,50 @@
  */
 
 #include <stdlib.h>
+#include <assert.h>
 
 #include "stack.h"
 #include "list.h"
+#include "chunkstack.h"
 
 /*
  * This is the structure that will be used to represent a stack.  This
  * structure specifically contains a single field representing a linked list
  * that should be used as the underlying data storage for the stack.
  *
- * You should not modify this structure.
+ * A stack can instead keep its values in a chunked array (see
+ * stack_create_backend()), in which case `list` is NULL and the values are in
+ * `chunks`.  `list` stays the first field, so a list-backed stack still
+ * starts with its list.
  */
 struct stack {
   struct list* list;
+  struct chunkstack chunks;
 };
 
 /*
  * This function should allocate and initialize a new, empty stack and return
- * a pointer to it.
+ * a pointer to it.  The stack uses the default backend, STACK_DEFAULT_BACKEND.
  */
 struct stack* stack_create() {
+	return stack_create_backend(STACK_DEFAULT_BACKEND);
+}
+
+/*
+ * This function allocates and initializes a new, empty stack that stores its
+ * values with a given backend, and returns a pointer to it.  Either way, the
+ * stack behaves exactly the same.
+ *
+ * Params:
+ *   backend - STACK_LIST to store the values in a linked list, or
+ *     STACK_ARRAY to store them in a chunked array.
+ */
+struct stack* stack_create_backend(enum stack_backend backend) {
 	//  Allocates memory for the stack
 	struct stack* stack = malloc(sizeof(struct stack));
-	// Uses list create to initliize stack
-	stack->list = list_create();
+	// Uses list create to initliize stack, unless it is array-backed
+	stack->list = backend == STACK_LIST ? list_create() : NULL;
+	chunkstack_init(&stack->chunks);
 	return stack;
 }
 
@@ -51,7 +71,10 @@ void stack_free(struct stack* stack) {
 		return;
 	}
 	// Empty the contents of the stack
-	list_free(stack->list);
+	if (stack->list != NULL){
+		list_free(stack->list);
+	}
+	chunkstack_destroy(&stack->chunks);
 	// Frees stack itself
 	free(stack);
 	return;
@@ -70,10 +93,30 @@ int stack_isempty(struct stack* stack) {
 	if (stack == NULL){
 		return 1;
 	}
+	if (stack->list == NULL){
+		return chunkstack_isempty(&stack->chunks);
+	}
 	// Returns false if the head of the array is not NULL, indicating the stack is not empty
 	return list_head(stack->list) == NULL;
 }
 
+/*
+ * This function returns the number of values in a given stack.
+ *
+ * Params:
+ *   stack - the stack whose size is to be returned.  May not be NULL.
+ */
+int stack_size(struct stack* stack) {
+	if (stack == NULL){
+		return 0;
+	}
+	if (stack->list == NULL){
+		return chunkstack_size(&stack->chunks);
+	}
+	// The list keeps track of its own size
+	return list_size(stack->list);
+}
+
 /*
  * This function should push a new value onto a given stack.  The value to be
  * pushed is specified as a void pointer.  This function must have O(1)
@@ -88,6 +131,10 @@ void stack_push(struct stack* stack, void* val) {
 	if (stack == NULL){
 		return;
 	}
+	if (stack->list == NULL){
+		chunkstack_push(&stack->chunks, val);
+		return;
+	}
 	// Uses list_insert to push the specified value into the list
 	list_insert(stack->list, val);
 	return;
@@ -105,6 +152,9 @@ void* stack_top(struct stack* stack) {
 	if (stack == NULL){
 		return NULL;
 	}
+	if (stack->list == NULL){
+		return chunkstack_top(&stack->chunks);
+	}
 	// Uses list_head function, that I implemented, to return the value at the head
 	return list_head(stack->list);
 }
@@ -123,10 +173,61 @@ void* stack_pop(struct stack* stack) {
 	if (stack == NULL){
 		return NULL;
 	}
+	if (stack->list == NULL){
+		return chunkstack_pop(&stack->chunks);
+	}
 	// Moves to the top of the stack using stack_top function
 	void* top = stack_top(stack);
-	// Uses list_remove to remove the value at the top of the stack
-	list_remove(stack->list, top);
+	// Uses list_remove_head to remove the value at the top of the stack
+	list_remove_head(stack->list);
 	// Returns the value that was removed
 	return top;
 }
+
+/*
+ * This function returns a checkpoint of a given stack, which can be passed to
+ * stack_rollback() later to discard every value pushed since.  The
+ * checkpoint is the number of values in the stack, so it stays valid as long
+ * as the stack isn't popped below that point in the meantime.
+ *
+ * Params:
+ *   stack - the stack to take a checkpoint of.  May not be NULL.
+ */
+int stack_mark(struct stack* stack) {
+	if (stack == NULL){
+		return 0;
+	}
+	if (stack->list == NULL){
+		return chunkstack_mark(&stack->chunks);
+	}
+	return list_size(stack->list);
+}
+
+/*
+ * This function discards every value pushed onto a given stack since a
+ * checkpoint was taken with stack_mark().  For an array-backed stack, this
+ * drops whole chunks at once without touching the values, so it doesn't
+ * depend on how many values are discarded; a list-backed stack has to
+ * remove its nodes one at a time.  Freeing any memory associated with the
+ * discarded values is the responsibility of the caller.
+ *
+ * Params:
+ *   stack - the stack to roll back.  May not be NULL.
+ *   mark - the checkpoint to roll back to.  Must be between 0 and the
+ *     number of values in the stack (inclusive).
+ */
+void stack_rollback(struct stack* stack, int mark) {
+	if (stack == NULL){
+		return;
+	}
+	if (stack->list == NULL){
+		chunkstack_rollback(&stack->chunks, mark);
+		return;
+	}
+	// A checkpoint above the top of the stack means it was popped below it
+	assert(mark >= 0 && mark <= list_size(stack->list));
+	// Removes values from the head of the list until it is back to mark
+	while (list_size(stack->list) > mark){
+		list_remove_head(stack->list);
+	}
+}
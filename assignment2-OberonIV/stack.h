@@ -13,15 +13,35 @@
  */
 struct stack;
 
+/*
+ * The ways a stack can store its values: in a linked list, or in a chunked
+ * array (see chunkstack.h), which doesn't allocate memory on every push.
+ * stack_create() makes a stack with STACK_DEFAULT_BACKEND, which can be
+ * changed when compiling stack.c (e.g. -DSTACK_DEFAULT_BACKEND=STACK_ARRAY);
+ * stack_create_backend() chooses the backend for one stack.
+ */
+enum stack_backend {
+  STACK_LIST,
+  STACK_ARRAY
+};
+
+#ifndef STACK_DEFAULT_BACKEND
+#define STACK_DEFAULT_BACKEND STACK_LIST
+#endif
+
 /*
  * Stack interface function prototypes.  Refer to stack.c for documentation
  * about each of these functions.
  */
 struct stack* stack_create();
+struct stack* stack_create_backend(enum stack_backend backend);
 void stack_free(struct stack* stack);
 int stack_isempty(struct stack* stack);
+int stack_size(struct stack* stack);
 void stack_push(struct stack* stack, void* val);
 void* stack_top(struct stack* stack);
 void* stack_pop(struct stack* stack);
+int stack_mark(struct stack* stack);
+void stack_rollback(struct stack* stack, int mark);
 
 #endif
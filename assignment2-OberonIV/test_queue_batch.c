@@ -0,0 +1,125 @@
+/*
+ * This file contains executable code for testing the batch queue operations,
+ * queue_enqueue_n(), queue_dequeue_n() and queue_drain().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "queue.h"
+#include "dynarray.h"
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Dequeues up to `max` values from `q` into `out` with one call to
+ * queue_dequeue_n() and checks that exactly `expect` values came out, equal
+ * to `vals` starting at index `*front`.  Returns 1 if they were right.
+ */
+int dequeue_n_matches(struct queue* q, void** out, int max, int** vals,
+    int* front, int expect) {
+  int i, ok;
+  ok = queue_dequeue_n(q, out, max) == expect;
+  for (i = 0; ok && i < expect; i++) {
+    ok = out[i] == vals[(*front)++];
+  }
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  int n = 1000, i, front = 0, back = 0, ok;
+  int* data;
+  int** vals;
+  void** out;
+  struct queue* q;
+  struct dynarray* drained;
+
+  data = malloc(n * sizeof(int));
+  vals = malloc(n * sizeof(int*));
+  out = malloc(n * sizeof(void*));
+  for (i = 0; i < n; i++) {
+    data[i] = i;
+    vals[i] = &data[i];
+  }
+
+  printf("== Batch queue operations\n");
+  q = queue_create();
+
+  /*
+   * Move the front of the queue most of the way along the circular buffer, so
+   * the next batch wraps around its end.
+   */
+  printf("Enqueueing and dequeueing a batch... ");
+  queue_enqueue_n(q, (void**)vals + back, 6);
+  back += 6;
+  check(dequeue_n_matches(q, out, 5, vals, &front, 5)
+      && queue_front(q) == vals[front]);
+
+  printf("Enqueueing a batch that wraps around the buffer... ");
+  queue_enqueue_n(q, (void**)vals + back, 6);
+  back += 6;
+  check(dequeue_n_matches(q, out, 7, vals, &front, 7) && queue_isempty(q));
+
+  printf("Dequeueing more values than the queue holds... ");
+  queue_enqueue_n(q, (void**)vals + back, 3);
+  back += 3;
+  queue_enqueue(q, vals[back++]);
+  check(dequeue_n_matches(q, out, 100, vals, &front, 4)
+      && dequeue_n_matches(q, out, 100, vals, &front, 0)
+      && queue_isempty(q));
+
+  printf("Growing the queue with batches while it is wrapped... ");
+  queue_enqueue_n(q, (void**)vals + back, 7);
+  back += 7;
+  ok = dequeue_n_matches(q, out, 6, vals, &front, 6);
+  for (i = 1; ok && back + i <= n / 2; i *= 2) {
+    queue_enqueue_n(q, (void**)vals + back, i);
+    back += i;
+    ok = queue_front(q) == vals[front];
+  }
+  check(ok && dequeue_n_matches(q, out, n, vals, &front, back - front));
+
+  printf("Draining a queue... ");
+  queue_enqueue_n(q, (void**)vals + back, 50);
+  back += 50;
+  ok = dequeue_n_matches(q, out, 10, vals, &front, 10);
+  drained = queue_drain(q);
+  ok = ok && queue_isempty(q) && dynarray_size(drained) == back - front;
+  for (i = 0; ok && i < dynarray_size(drained); i++) {
+    ok = dynarray_get(drained, i) == vals[front + i];
+  }
+  front = back;
+  dynarray_free(drained);
+  check(ok);
+
+  printf("Reusing a drained queue... ");
+  queue_enqueue(q, vals[back++]);
+  queue_enqueue_n(q, (void**)vals + back, 20);
+  back += 20;
+  ok = queue_front(q) == vals[front] && queue_dequeue(q) == vals[front++];
+  check(ok && dequeue_n_matches(q, out, 50, vals, &front, 20)
+      && queue_isempty(q));
+
+  printf("Draining an empty queue... ");
+  drained = queue_drain(q);
+  check(dynarray_size(drained) == 0 && queue_isempty(q));
+  dynarray_free(drained);
+
+  printf("Passing a NULL queue to the batch operations... ");
+  queue_enqueue_n(NULL, (void**)vals, 5);
+  check(queue_dequeue_n(NULL, out, 5) == 0 && queue_drain(NULL) == NULL);
+
+  queue_free(q);
+  free(out);
+  free(vals);
+  free(data);
+  return 0;
+}
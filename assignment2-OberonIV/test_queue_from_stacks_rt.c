@@ -0,0 +1,104 @@
+/*
+ * This file contains executable code for testing the real-time
+ * queue-from-stacks implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "queue_from_stacks_rt.h"
+
+/*
+ * The most values one operation can push onto or pop off of the stacks: two
+ * pops for the dequeue itself, up to five for each of the 3 steps of
+ * recopying, and up to 3 leftover values discarded.
+ */
+#define MAX_WORK (2 + 5 * 3 + 3)
+
+/*
+ * The most work done by any operation run() has done so far.
+ */
+int max_work = 0;
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Enqueues values from `vals` starting at index `*back` into a real-time
+ * queue-from-stacks and dequeues values from it, checking them against
+ * `vals` starting at index `*front`: `n` rounds of `enq` enqueues followed by
+ * `deq` dequeues.  Returns 1 if every front and dequeued value was right.
+ * Also keeps track of the most work done by one operation in `max_work`.
+ */
+int run(struct queue_from_stacks_rt* q, int* vals, int* front, int* back,
+    int n, int enq, int deq) {
+  int i, j, ok = 1;
+  for (i = 0; ok && i < n; i++) {
+    for (j = 0; j < enq; j++) {
+      queue_from_stacks_rt_enqueue(q, &vals[(*back)++]);
+      if (queue_from_stacks_rt_work(q) > max_work)
+        max_work = queue_from_stacks_rt_work(q);
+    }
+    for (j = 0; ok && j < deq && *front < *back; j++) {
+      ok = queue_from_stacks_rt_front(q) == &vals[*front]
+        && queue_from_stacks_rt_dequeue(q) == &vals[*front];
+      if (queue_from_stacks_rt_work(q) > max_work)
+        max_work = queue_from_stacks_rt_work(q);
+      (*front)++;
+    }
+  }
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  int n = 1000000, i, front = 0, back = 0, ok;
+  struct queue_from_stacks_rt* q;
+  int* vals;
+
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  printf("== Real-time queue-from-stacks\n");
+  q = queue_from_stacks_rt_create();
+  printf("Checking that a new queue is empty... ");
+  check(queue_from_stacks_rt_isempty(q) && !queue_from_stacks_rt_front(q)
+      && !queue_from_stacks_rt_dequeue(q));
+
+  printf("Enqueueing and dequeueing one value at a time... ");
+  check(run(q, vals, &front, &back, 1000, 1, 1)
+      && queue_from_stacks_rt_isempty(q));
+
+  printf("Enqueueing many values, then dequeueing half of them... ");
+  ok = run(q, vals, &front, &back, 1, 100000, 50000);
+  check(ok && !queue_from_stacks_rt_isempty(q));
+
+  printf("Interleaving uneven runs of enqueues and dequeues... ");
+  ok = 1;
+  for (i = 1; ok && i < 200; i++) {
+    ok = run(q, vals, &front, &back, 10, i % 7 + 1, i % 5 + 1)
+      && run(q, vals, &front, &back, 3, i, i % 11);
+  }
+  check(ok);
+
+  printf("Dequeueing the rest... ");
+  ok = run(q, vals, &front, &back, 1, 0, back - front);
+  check(ok && queue_from_stacks_rt_isempty(q)
+      && !queue_from_stacks_rt_dequeue(q));
+
+  printf("Checking that no operation moved more than %d values (%d)... ",
+      MAX_WORK, max_work);
+  check(max_work <= MAX_WORK);
+
+  queue_from_stacks_rt_free(q);
+  free(vals);
+  return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * This file contains executable code for testing stack_mark() and
+ * stack_rollback() with both of the stack's backends.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "stack.h"
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Pops every value off of `stack`, checking that they are `vals[n-1]` down to
+ * `vals[0]`.  Returns 1 if they were and the stack ended up empty.
+ */
+int pops_match(struct stack* stack, int* vals, int n) {
+  int i;
+  for (i = n - 1; i >= 0; i--) {
+    if (stack_mark(stack) != i + 1 || stack_pop(stack) != &vals[i])
+      return 0;
+  }
+  return stack_isempty(stack) && stack_mark(stack) == 0;
+}
+
+/*
+ * Returns 1 if rolling `stack` back to `mark` makes the program abort, which
+ * is checked in a child process so this one can carry on.
+ */
+int rollback_aborts(struct stack* stack, int mark) {
+  int status;
+  pid_t pid;
+
+  fflush(stdout);
+  pid = fork();
+  if (pid == 0) {
+    freopen("/dev/null", "w", stderr);
+    stack_rollback(stack, mark);
+    _exit(0);
+  }
+  return pid > 0 && waitpid(pid, &status, 0) == pid
+      && WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+/*
+ * Function to run the rollback tests on one stack, which must be empty.
+ * `vals` must hold at least `n` values, and `n` should be big enough for an
+ * array-backed stack to need several chunks.
+ */
+void test_rollback(struct stack* stack, int* vals, int n) {
+  int i, mark, inner, ok;
+
+  printf("Rolling back to a checkpoint of an empty stack... ");
+  mark = stack_mark(stack);
+  for (i = 0; i < n; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  stack_rollback(stack, mark);
+  check(mark == 0 && stack_isempty(stack) && stack_top(stack) == NULL);
+
+  printf("Rolling back %d values pushed after a checkpoint... ", n - 10);
+  for (i = 0; i < 10; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  mark = stack_mark(stack);
+  for (i = 10; i < n; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  stack_rollback(stack, mark);
+  check(stack_mark(stack) == 10 && stack_top(stack) == &vals[9]);
+
+  printf("Rolling back to the current checkpoint... ");
+  stack_rollback(stack, stack_mark(stack));
+  check(stack_mark(stack) == 10 && stack_top(stack) == &vals[9]);
+
+  printf("Rolling back to nested checkpoints... ");
+  for (i = 10; i < n / 2; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  inner = stack_mark(stack);
+  for (i = n / 2; i < n; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  stack_rollback(stack, inner);
+  ok = stack_mark(stack) == n / 2 && stack_top(stack) == &vals[n / 2 - 1];
+  stack_rollback(stack, mark);
+  check(ok && pops_match(stack, vals, 10));
+
+  printf("Pushing and popping after rolling back... ");
+  for (i = 0; i < n; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  stack_rollback(stack, 0);
+  for (i = 0; i < n / 3; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  check(pops_match(stack, vals, n / 3));
+
+  printf("Rejecting a checkpoint above the top of the stack... ");
+  for (i = 0; i < 10; i++) {
+    stack_push(stack, &vals[i]);
+  }
+  check(rollback_aborts(stack, 11) && rollback_aborts(stack, -1)
+      && pops_match(stack, vals, 10));
+}
+
+int main(int argc, char** argv) {
+  int n = 1000, i;
+  int* vals;
+  struct stack* stack;
+
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  printf("== Default (list-backed) stack\n");
+  stack = stack_create();
+  test_rollback(stack, vals, n);
+  stack_free(stack);
+
+  printf("\n== Array-backed stack\n");
+  stack = stack_create_backend(STACK_ARRAY);
+  test_rollback(stack, vals, n);
+  stack_free(stack);
+
+  free(vals);
+  return 0;
+}
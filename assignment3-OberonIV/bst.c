@@ -475,8 +475,9 @@ struct bst_iterator {
 struct bst_iterator* bst_iterator_create(struct bst* bst) {
   // Allocates the memory for the iteratior
   struct bst_iterator* iter = (struct bst_iterator*)malloc(sizeof(struct bst_iterator));
-  // Calls stack_create from stack.c to initalize the stack in the iterator
-  iter->stack = stack_create();
+  // Calls stack_create_backend from stack.c to initalize the stack in the
+  // iterator, array-backed so iterating doesn't allocate a node per push
+  iter->stack = stack_create_backend(STACK_ARRAY);
   // Sets the current node to the root
   struct bst_node* current = bst->root;
   // Logic for traversing down tree
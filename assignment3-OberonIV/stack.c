@@ -1,7 +1,7 @@
 /*
- * This file contains a simple implementation of a linked list-based stack.
- * See the documentation below for more information on the individual functions
- * in this implementation.  You should not modify anything in this file.
+ * This file contains a simple implementation of a stack, backed by either a
+ * linked list or a chunked array.  See the documentation below for more
+ * information on the individual functions in this implementation.
  */
 
 #include <stdlib.h>
@@ -9,23 +9,40 @@
 
 #include "stack.h"
 #include "list.h"
+#include "chunkstack.h"
 
 /*
- * This is the structure that represents a stack.  It contains a single field
- * representing a linked list that is used as the underlying data storage for
- * the stack.
+ * This is the structure that represents a stack.  If the stack is backed by a
+ * linked list, `list` is that list; otherwise `list` is NULL and the values
+ * are stored in `chunks`.
  */
 struct stack {
   struct list* list;
+  struct chunkstack chunks;
 };
 
 /*
- * This function allocates and initializes a new, empty stack and returns a
- * pointer to it.
+ * This function allocates and initializes a new, empty stack with the
+ * default backend (STACK_DEFAULT_BACKEND) and returns a pointer to it.
  */
 struct stack* stack_create() {
+  return stack_create_backend(STACK_DEFAULT_BACKEND);
+}
+
+/*
+ * This function allocates and initializes a new, empty stack that stores its
+ * values with a given backend, and returns a pointer to it.  Either way, the
+ * stack behaves exactly the same.
+ *
+ * Params:
+ *   backend - STACK_LIST to store the values in a linked list, or
+ *     STACK_ARRAY to store them in a chunked array.
+ */
+struct stack* stack_create_backend(enum stack_backend backend) {
   struct stack* stack = malloc(sizeof(struct stack));
-  stack->list = list_create();
+  assert(stack);
+  stack->list = backend == STACK_LIST ? list_create() : NULL;
+  chunkstack_init(&stack->chunks);
   return stack;
 }
 
@@ -39,7 +56,10 @@ struct stack* stack_create() {
  */
 void stack_free(struct stack* stack) {
   assert(stack);
-  list_free(stack->list);
+  if (stack->list) {
+    list_free(stack->list);
+  }
+  chunkstack_destroy(&stack->chunks);
   free(stack);
 }
 
@@ -53,9 +73,26 @@ void stack_free(struct stack* stack) {
  */
 int stack_isempty(struct stack* stack) {
   assert(stack);
+  if (!stack->list) {
+    return chunkstack_isempty(&stack->chunks);
+  }
   return list_isempty(stack->list);
 }
 
+/*
+ * This function returns the number of values in a given stack.
+ *
+ * Params:
+ *   stack - the stack whose size is to be returned.  May not be NULL.
+ */
+int stack_size(struct stack* stack) {
+  assert(stack);
+  if (!stack->list) {
+    return chunkstack_size(&stack->chunks);
+  }
+  return list_size(stack->list);
+}
+
 /*
  * This function pushes a new value onto a given stack.  The value to be
  * pushed is specified as a void pointer.
@@ -67,6 +104,10 @@ int stack_isempty(struct stack* stack) {
  */
 void stack_push(struct stack* stack, void* val) {
   assert(stack);
+  if (!stack->list) {
+    chunkstack_push(&stack->chunks, val);
+    return;
+  }
   list_insert(stack->list, val);
 }
 
@@ -79,6 +120,9 @@ void stack_push(struct stack* stack, void* val) {
  */
 void* stack_top(struct stack* stack) {
   assert(stack);
+  if (!stack->list) {
+    return chunkstack_top(&stack->chunks);
+  }
   return list_head(stack->list);
 }
 
@@ -93,7 +137,52 @@ void* stack_top(struct stack* stack) {
  */
 void* stack_pop(struct stack* stack) {
   assert(stack);
+  if (!stack->list) {
+    return chunkstack_pop(&stack->chunks);
+  }
   void* head = list_head(stack->list);
   list_remove_head(stack->list);
   return head;
 }
+
+/*
+ * This function returns a checkpoint of a given stack, which can be passed to
+ * stack_rollback() later to discard every value pushed since.  The
+ * checkpoint is the number of values in the stack, so it stays valid as long
+ * as the stack isn't popped below that point in the meantime.
+ *
+ * Params:
+ *   stack - the stack to take a checkpoint of.  May not be NULL.
+ */
+int stack_mark(struct stack* stack) {
+  assert(stack);
+  if (!stack->list) {
+    return chunkstack_mark(&stack->chunks);
+  }
+  return list_size(stack->list);
+}
+
+/*
+ * This function discards every value pushed onto a given stack since a
+ * checkpoint was taken with stack_mark().  For an array-backed stack, this
+ * drops whole chunks at once without touching the values, so it doesn't
+ * depend on how many values are discarded; a list-backed stack has to
+ * remove its nodes one at a time.  Freeing any memory associated with the
+ * discarded values is the responsibility of the caller.
+ *
+ * Params:
+ *   stack - the stack to roll back.  May not be NULL.
+ *   mark - the checkpoint to roll back to.  Must be between 0 and the
+ *     number of values in the stack (inclusive).
+ */
+void stack_rollback(struct stack* stack, int mark) {
+  assert(stack);
+  if (!stack->list) {
+    chunkstack_rollback(&stack->chunks, mark);
+    return;
+  }
+  assert(mark >= 0 && mark <= list_size(stack->list));
+  while (list_size(stack->list) > mark) {
+    list_remove_head(stack->list);
+  }
+}
@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "pq.h"
+#include "dynarray_typed.h"
 #define DATA_FILE "airports.dat"
 #define START_NODE 0
 
@@ -18,21 +19,26 @@ struct Edge{
 	int path;
 	int weight;
 };
+DYNARRAY_DECLARE(edge, struct Edge)
+// Struct that represents each edge as it is read from the file, before it is
+// added to the node it starts from
+struct EdgeRecord{
+	int curr;
+	struct Edge edge;
+};
+DYNARRAY_DECLARE(edge_record, struct EdgeRecord)
 // Struct that represents each node(airport) in the graph
 struct Node{
-	int num_edge;
-	struct Edge* edge;
+	struct dynarray_edge* edges;
 };
 // Function that frees the memory of the graph
-void dijkstra_free(struct Node* graph, int n_nodes, int* edge_count){
+void dijkstra_free(struct Node* graph, int n_nodes){
 	// Frees the memory for each edge in the graph
 	for(int i = 0; i < n_nodes; i++){
-		free(graph[i].edge);
+		dynarray_edge_free(graph[i].edges);
 	}
 	// Frees the graph itself
 	free(graph);
-	// Frees the edge count
-	free(edge_count);
 }
 
 void initalize_graph(int n_nodes, int** cost, int** prev, int** node){
@@ -76,11 +82,13 @@ void dijkstra(struct Node* graph, int n_nodes, int start_node){
 			// Sets node to visited
 			node[curr] = 1;
 			// Updates the cost of each node
-			for(int j = 0; j < graph[curr].num_edge; j++){
+			int num_edge = dynarray_edge_size(graph[curr].edges);
+			for(int j = 0; j < num_edge; j++){
+				struct Edge* edge = dynarray_edge_at(graph[curr].edges, j);
 				// Sets destination node
-				int dest = graph[curr].edge[j].path;
+				int dest = edge->path;
 				// Sets edge weight 
-				int weight = graph[curr].edge[j].weight;
+				int weight = edge->weight;
 				// Checks if theres a shorter path to dest
 				if(cost[curr] + weight < cost[dest]){
 					// Updates the cost and prev
@@ -122,27 +130,35 @@ int main(int argc, char const *argv[]) {
 	// Allocates memory for graph
 	struct Node* graph = (struct Node*)malloc(n_nodes * sizeof(struct Node));
 	// Allocates memory for edge count
-	int* edge_count = (int*)malloc(n_nodes * sizeof(int));
+	int* edge_count = (int*)calloc(n_nodes, sizeof(int));
 	
-	// Initalize edge array and edge count
+	// Reads edges from file into one array, sized once for all of them,
+	// and counts how many edges start from each node
+	struct dynarray_edge_record* records = dynarray_edge_record_create();
+	dynarray_edge_record_reserve(records, n_edges);
+	for(int i = 0; i < n_edges; i++){
+		struct EdgeRecord record;
+		fscanf(file, "%d %d %d", &record.curr, &record.edge.path, &record.edge.weight);
+		dynarray_edge_record_insert(records, record);
+		edge_count[record.curr]++;
+	}
+	fclose(file);
+
+	// Initalize each edge array with exactly enough room for its edges
 	for(int i = 0; i < n_nodes; i++){
-		graph[i].num_edge = 0;
-		graph[i].edge = (struct Edge*)malloc(n_edges * sizeof(struct Edge)); 
-		edge_count[i] = 0;
+		graph[i].edges = dynarray_edge_create();
+		dynarray_edge_reserve(graph[i].edges, edge_count[i]);
 	}
 
-	// Reads edges from file and populates graph array
+	// Populates graph array
 	for(int i = 0; i < n_edges; i++){
-		int curr, dest, weight;
-		fscanf(file, "%d %d %d", &curr, &dest, &weight);
-		int index = edge_count[curr]++;
-		graph[curr].edge[index].path = dest;
-		graph[curr].edge[index].weight = weight;
-		graph[curr].num_edge++;
+		struct EdgeRecord* record = dynarray_edge_record_at(records, i);
+		dynarray_edge_insert(graph[record->curr].edges, record->edge);
 	}
-	fclose(file);
+	dynarray_edge_record_free(records);
+	free(edge_count);
 	// Calls algorithm and frees memory when algorithm is done
 	dijkstra(graph, n_nodes, START_NODE);
-	dijkstra_free(graph, n_nodes, edge_count);
+	dijkstra_free(graph, n_nodes);
 	return 0;
 }
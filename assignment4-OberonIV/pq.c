@@ -11,19 +11,24 @@
 #include <stdlib.h>
 
 #include "pq.h"
-#include "dynarray.h"
+#include "dynarray_typed.h"
+
+// Struct that represents elements in the priority queue. 
+struct pq_element{
+	void* value;
+	int priority;
+};
+
+// Typed dynarray that stores pq_elements by value, so inserting does not need
+// a separate malloc for every element
+DYNARRAY_DECLARE(pq_element, struct pq_element)
 
 /*
  * This is the structure that represents a priority queue.  You must define
  * this struct to contain the data needed to implement a priority queue.
  */
 struct pq{
-	struct dynarray* array;
-};
-// Struct that represents elements in the priority queue. 
-struct pq_element{
-	void* value;
-	int priority;
+	struct dynarray_pq_element* array;
 };
 
 /*
@@ -34,7 +39,7 @@ struct pq* pq_create() {
 	// Allocates memory for priority queue
 	struct pq* pq = malloc(sizeof(struct pq));
 	// Initializes dynarray
-	pq->array = dynarray_create();
+	pq->array = dynarray_pq_element_create();
 	return pq;
 }
 
@@ -50,12 +55,8 @@ struct pq* pq_create() {
  *   pq - the priority queue to be destroyed.  May not be NULL.
  */
 void pq_free(struct pq* pq) {
-	// Frees each element in the dynarray
-	for(int i = 0; i < dynarray_size(pq->array); i++){
-		free(dynarray_get(pq->array, i));
-	}
-	// Frees the dynamic array
-	dynarray_free(pq->array);
+	// Frees the dynamic array, elements are stored inside it so they go with it
+	dynarray_pq_element_free(pq->array);
 	// Frees the queue
 	free(pq);
 }
@@ -74,7 +75,7 @@ void pq_free(struct pq* pq) {
  */
 int pq_isempty(struct pq* pq) {
 	// Returns 1 if priority queue is empty
-	return dynarray_size(pq->array) == 0;
+	return dynarray_pq_element_size(pq->array) == 0;
 }
 
 
@@ -96,27 +97,25 @@ int pq_isempty(struct pq* pq) {
  *     be the FIRST one returned.
  */
 void pq_insert(struct pq* pq, void* value, int priority) {
-	// Creates a new element
-	struct pq_element* element = malloc(sizeof(struct pq_element));
-	// Initializes the element with wanted value and priority
-	element->value = value;
-	element->priority = priority;
+	// Creates a new element with wanted value and priority
+	struct pq_element element;
+	element.value = value;
+	element.priority = priority;
 	// Inserts element into array
-	dynarray_insert(pq->array, element);
+	dynarray_pq_element_insert(pq->array, element);
 	// Sets the index for new element at the end of the dynarray
-	int index = dynarray_size(pq->array) - 1;
+	int index = dynarray_pq_element_size(pq->array) - 1;
 	// Uses pseudocode from lexture 18
 	while(index > 0){
 		// Sets parent element (i - 1) / 2
 		int parent_index = (index - 1) / 2;
-		// Gets parent and current elements for comparison
-		struct pq_element* parent = dynarray_get(pq->array, parent_index);
-		struct pq_element* current = dynarray_get(pq->array, index);
+		// Gets parent element for comparison
+		struct pq_element parent = dynarray_pq_element_get(pq->array, parent_index);
 		// Compares inserted element with parent
-		if(current->priority < parent->priority){
-			// Swaps the elements if priority of current is higher than parent
-			dynarray_set(pq->array, index, parent);
-			dynarray_set(pq->array, parent_index, current);
+		if(element.priority < parent.priority){
+			// Moves the parent down into the hole instead of swapping, the
+			// new element is only written once its final spot is found
+			dynarray_pq_element_set(pq->array, index, parent);
 			index = parent_index;
 		}
 		else{
@@ -124,6 +123,7 @@ void pq_insert(struct pq* pq, void* value, int priority) {
 			break;
 		}
 	}
+	dynarray_pq_element_set(pq->array, index, element);
 	return;
 }
 
@@ -145,10 +145,8 @@ void* pq_first(struct pq* pq) {
 	if(pq_isempty(pq)){
 		return NULL;
 	}
-	// Sets element as first element in dynarray
-	struct pq_element* element = dynarray_get(pq->array, 0);
-	// Returns value
-	return element->value;
+	// Returns value of first element in dynarray
+	return dynarray_pq_element_at(pq->array, 0)->value;
 }
 
 
@@ -169,10 +167,8 @@ int pq_first_priority(struct pq* pq) {
 	if(pq_isempty(pq)){
 		return -1; 
 	}
-	// Sets element as first element in dynarray
-	struct pq_element* element = dynarray_get(pq->array, 0);
-	// Returns priority
-	return element->priority;
+	// Returns priority of first element in dynarray
+	return dynarray_pq_element_at(pq->array, 0)->priority;
 }
 
 
@@ -195,8 +191,10 @@ int pq_first_priority(struct pq* pq) {
  
  // Seperate function for comparison so remove_first is short
 void heap_compare(struct pq* pq, int index){
-	// Sets size to the size of the dynarray
-	int size = dynarray_size(pq->array);
+	// Sets size to the size of the dynarray, and elements to its storage so
+	// the loop reads elements directly
+	int size = dynarray_pq_element_size(pq->array);
+	struct pq_element* elements = pq->array->data;
 	while(1){
 		// Computes indices of the children of the replacement element
 		int left_child_index = 2 * index + 1;
@@ -205,18 +203,14 @@ void heap_compare(struct pq* pq, int index){
 		
 		// Sees if left child is smaller than element
 		if(left_child_index < size){
-			struct pq_element* left_child = dynarray_get(pq->array, left_child_index);
-			struct pq_element* smallest = dynarray_get(pq->array, smallest_index);
-			if(left_child->priority < smallest->priority){
+			if(elements[left_child_index].priority < elements[smallest_index].priority){
 				// Sets smallest index to left child
 				smallest_index = left_child_index;
 			}
 		}
 		// Sees if right child is smaller than element
 		if(right_child_index < size){
-			struct pq_element* right_child = dynarray_get(pq->array, right_child_index);
-			struct pq_element* smallest = dynarray_get(pq->array, smallest_index);
-			if(right_child->priority < smallest->priority){
+			if(elements[right_child_index].priority < elements[smallest_index].priority){
 				// Sets the smallest index to right child
 				smallest_index = right_child_index;
 			}
@@ -225,37 +219,33 @@ void heap_compare(struct pq* pq, int index){
 			break;
 		}
 		// Creates temp element, then swaps the elements
-		struct pq_element* temp = dynarray_get(pq->array, index);
-		dynarray_set(pq->array, index, dynarray_get(pq->array, smallest_index));
-		dynarray_set(pq->array, smallest_index, temp);
+		struct pq_element temp = elements[index];
+		elements[index] = elements[smallest_index];
+		elements[smallest_index] = temp;
 		index = smallest_index;
 	}
 }
 
 void* pq_remove_first(struct pq* pq) {
 	// Sets the size of dynarray
-	int size = dynarray_size(pq->array);
+	int size = dynarray_pq_element_size(pq->array);
 	if(size == 0){
 		return NULL;
 	}
 	
-	// Remembers the first element
-	// Sets first element to root
-	struct pq_element* first_element = dynarray_get(pq->array, 0);
-	// Sets first value to the value
-	void* first_value = first_element->value;
-	free(first_element);
+	// Remembers the value of the first element, the root
+	void* first_value = dynarray_pq_element_at(pq->array, 0)->value;
 	
 	if(size == 1){
-		dynarray_remove(pq->array, 0);
+		dynarray_pq_element_remove(pq->array, 0);
 		return first_value;
 	}
 	// Sets last element to last element in dynarray
-	struct pq_element* last_element = dynarray_get(pq->array, size - 1);
+	struct pq_element last_element = dynarray_pq_element_get(pq->array, size - 1);
 	// Sets root to last element
-	dynarray_set(pq->array, 0 , last_element);
+	dynarray_pq_element_set(pq->array, 0 , last_element);
 	// Removes last element
-	dynarray_remove(pq->array, size - 1);
+	dynarray_pq_element_remove(pq->array, size - 1);
 	
 	heap_compare(pq, 0);
 	// Returns the value to be removed
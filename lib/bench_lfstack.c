@@ -0,0 +1,105 @@
+/*
+ * This is a small program to compare the throughput of the lock-free stack
+ * against a chunked stack protected by a mutex, with increasing numbers of
+ * threads.  Each thread repeatedly pushes a value and pops one, so the stack
+ * stays small and every operation contends for its top.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "chunkstack.h"
+#include "lfstack.h"
+
+#define OPS_PER_THREAD 2000000
+#define MAX_THREADS 8
+
+/*
+ * The stack being measured: either a lock-free stack or a chunked stack and
+ * the mutex protecting it.
+ */
+struct bench {
+  struct lfstack* lf;
+  struct chunkstack cs;
+  pthread_mutex_t lock;
+};
+
+void* run_locked(void* arg) {
+  struct bench* b = arg;
+  int i;
+  for (i = 0; i < OPS_PER_THREAD / 2; i++) {
+    pthread_mutex_lock(&b->lock);
+    chunkstack_push(&b->cs, b);
+    pthread_mutex_unlock(&b->lock);
+    pthread_mutex_lock(&b->lock);
+    chunkstack_pop(&b->cs);
+    pthread_mutex_unlock(&b->lock);
+  }
+  return NULL;
+}
+
+void* run_lockfree(void* arg) {
+  struct bench* b = arg;
+  int i;
+  for (i = 0; i < OPS_PER_THREAD / 2; i++) {
+    lfstack_push(b->lf, b);
+    lfstack_pop(b->lf);
+  }
+  return NULL;
+}
+
+/*
+ * Runs `run` on `threads` threads at once and returns the throughput in
+ * millions of operations per second.
+ */
+double measure(void* (*run)(void*), struct bench* b, int threads) {
+  pthread_t ids[MAX_THREADS];
+  struct timespec start, end;
+  int i;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < threads; i++) {
+    pthread_create(&ids[i], NULL, run, b);
+  }
+  for (i = 0; i < threads; i++) {
+    pthread_join(ids[i], NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double secs = (end.tv_sec - start.tv_sec)
+    + (end.tv_nsec - start.tv_nsec) / 1e9;
+  return (double)threads * OPS_PER_THREAD / secs / 1e6;
+}
+
+int main(int argc, char** argv) {
+  struct bench b;
+  int threads;
+
+  printf("%8s %12s %12s %12s\n", "threads", "mutex", "lock-free",
+    "elimination");
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    double locked, lockfree, elim;
+
+    chunkstack_init(&b.cs);
+    pthread_mutex_init(&b.lock, NULL);
+    locked = measure(run_locked, &b, threads);
+    pthread_mutex_destroy(&b.lock);
+    chunkstack_destroy(&b.cs);
+
+    b.lf = lfstack_create();
+    lockfree = measure(run_lockfree, &b, threads);
+    lfstack_free(b.lf);
+
+    b.lf = lfstack_create_with_elimination(threads / 2 ? threads / 2 : 1);
+    elim = measure(run_lockfree, &b, threads);
+    lfstack_free(b.lf);
+
+    printf("%8d %9.1f M/s %9.1f M/s %9.1f M/s\n", threads, locked, lockfree,
+      elim);
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * This is a small program to measure the throughput and latency of the MPMC
+ * queue, with its blocking enqueue and dequeue, against a bounded ring buffer
+ * protected by a mutex and two condition variables.  Half of the threads
+ * produce and half consume (a single thread does both in turn).  Every
+ * message carries the time it was enqueued, so consumers can record how long
+ * each one spent in the queue.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "mpmcqueue.h"
+
+#define NUM_MESSAGES 1000000
+#define CAPACITY 1024
+#define MAX_THREADS 64
+
+/*
+ * A bounded queue protected by a mutex, as the baseline.
+ */
+struct lockedqueue {
+  void* vals[CAPACITY];
+  int head;
+  int size;
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+};
+
+void locked_enqueue(struct lockedqueue* q, void* val) {
+  pthread_mutex_lock(&q->lock);
+  while (q->size == CAPACITY) {
+    pthread_cond_wait(&q->not_full, &q->lock);
+  }
+  q->vals[(q->head + q->size++) % CAPACITY] = val;
+  pthread_cond_signal(&q->not_empty);
+  pthread_mutex_unlock(&q->lock);
+}
+
+void* locked_dequeue(struct lockedqueue* q) {
+  pthread_mutex_lock(&q->lock);
+  while (q->size == 0) {
+    pthread_cond_wait(&q->not_empty, &q->lock);
+  }
+  void* val = q->vals[q->head];
+  q->head = (q->head + 1) % CAPACITY;
+  q->size--;
+  pthread_cond_signal(&q->not_full);
+  pthread_mutex_unlock(&q->lock);
+  return val;
+}
+
+/*
+ * The queue being measured, and the work for each thread.  Each thread
+ * handles `n` messages, and consumers store the latency of each message, in
+ * nanoseconds, in `latencies`.
+ */
+struct bench {
+  struct mpmcqueue* queue;
+  struct lockedqueue* locked;
+  int n;
+  int both;
+  uint64_t* latencies;
+};
+
+uint64_t now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void send(struct bench* b) {
+  void* msg = (void*)(uintptr_t)now_ns();
+  if (b->queue) {
+    mpmcqueue_enqueue(b->queue, msg);
+  } else {
+    locked_enqueue(b->locked, msg);
+  }
+}
+
+void receive(struct bench* b, int i) {
+  void* msg = b->queue ? mpmcqueue_dequeue(b->queue)
+    : locked_dequeue(b->locked);
+  b->latencies[i] = now_ns() - (uint64_t)(uintptr_t)msg;
+}
+
+void* produce(void* arg) {
+  struct bench* b = arg;
+  int i;
+  for (i = 0; i < b->n; i++) {
+    send(b);
+    if (b->both) {
+      receive(b, i);
+    }
+  }
+  return NULL;
+}
+
+void* consume(void* arg) {
+  struct bench* b = arg;
+  int i;
+  for (i = 0; i < b->n; i++) {
+    receive(b, i);
+  }
+  return NULL;
+}
+
+int compare_u64(const void* a, const void* b) {
+  uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+/*
+ * Runs `threads` threads passing NUM_MESSAGES messages through either `queue`
+ * or `locked`, and prints the throughput and latency percentiles.
+ */
+void measure(const char* name, struct mpmcqueue* queue,
+    struct lockedqueue* locked, int threads) {
+  struct bench b[MAX_THREADS];
+  pthread_t ids[MAX_THREADS];
+  int pairs = threads > 1 ? threads / 2 : 1;
+  int per_thread = NUM_MESSAGES / pairs;
+  int total = per_thread * pairs;
+  uint64_t* latencies = malloc(total * sizeof(uint64_t));
+  int i;
+
+  uint64_t start = now_ns();
+  for (i = 0; i < threads; i++) {
+    int consumer = threads > 1 && i >= pairs;
+    b[i].queue = queue;
+    b[i].locked = locked;
+    b[i].n = per_thread;
+    b[i].both = threads == 1;
+    b[i].latencies = latencies + (consumer ? i - pairs : i) * per_thread;
+    pthread_create(&ids[i], NULL, consumer ? consume : produce, &b[i]);
+  }
+  for (i = 0; i < threads; i++) {
+    pthread_join(ids[i], NULL);
+  }
+  double secs = (now_ns() - start) / 1e9;
+
+  qsort(latencies, total, sizeof(uint64_t), compare_u64);
+  printf("%-8s %7d %9.2f M/s %10.1f us %10.1f us %10.1f us\n", name, threads,
+    total / secs / 1e6, latencies[total / 2] / 1e3,
+    latencies[(int)(total * 0.99)] / 1e3,
+    latencies[(int)(total * 0.999)] / 1e3);
+  free(latencies);
+}
+
+int main(int argc, char** argv) {
+  struct lockedqueue locked;
+  int threads;
+
+  locked.head = locked.size = 0;
+  pthread_mutex_init(&locked.lock, NULL);
+  pthread_cond_init(&locked.not_empty, NULL);
+  pthread_cond_init(&locked.not_full, NULL);
+
+  printf("%-8s %7s %13s %13s %13s %13s\n", "queue", "threads", "throughput",
+    "p50", "p99", "p99.9");
+  for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    struct mpmcqueue* queue = mpmcqueue_create(CAPACITY);
+    measure("mutex", NULL, &locked, threads);
+    measure("mpmc", queue, NULL, threads);
+    mpmcqueue_free(queue);
+  }
+
+  pthread_cond_destroy(&locked.not_full);
+  pthread_cond_destroy(&locked.not_empty);
+  pthread_mutex_destroy(&locked.lock);
+  return 0;
+}
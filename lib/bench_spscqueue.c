@@ -0,0 +1,148 @@
+/*
+ * This is a small program to measure the throughput of the SPSC queue between
+ * a producer thread and a consumer thread, one value at a time and in
+ * batches, against a dynamic array used as a queue behind a mutex.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "dynarray.h"
+#include "spscqueue.h"
+
+#define NUM_MESSAGES 20000000
+#define CAPACITY 4096
+#define BATCH 64
+
+/*
+ * The queue being measured: either an SPSC queue or a dynamic array and the
+ * mutex protecting it.  `batch` is the number of values moved per call.
+ */
+struct bench {
+  struct spscqueue* queue;
+  struct dynarray* da;
+  pthread_mutex_t lock;
+  int batch;
+};
+
+/*
+ * The message passed through the queue.  The consumer checks every message
+ * against it, so the loop can't be optimized away.
+ */
+static int message;
+
+void* produce_locked(void* arg) {
+  struct bench* b = arg;
+  int i;
+  for (i = 0; i < NUM_MESSAGES; i++) {
+    pthread_mutex_lock(&b->lock);
+    dynarray_insert(b->da, &message);
+    pthread_mutex_unlock(&b->lock);
+  }
+  return NULL;
+}
+
+void* consume_locked(void* arg) {
+  struct bench* b = arg;
+  int i = 0;
+  while (i < NUM_MESSAGES) {
+    void* val = NULL;
+    pthread_mutex_lock(&b->lock);
+    if (dynarray_size(b->da)) {
+      val = dynarray_remove_front(b->da);
+    }
+    pthread_mutex_unlock(&b->lock);
+    if (val == &message) {
+      i++;
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+void* produce(void* arg) {
+  struct bench* b = arg;
+  void* batch[BATCH];
+  int i, j;
+  for (i = 0; i < BATCH; i++) {
+    batch[i] = &message;
+  }
+  for (i = 0; i < NUM_MESSAGES; i += b->batch) {
+    for (j = 0; j < b->batch;) {
+      int k = spscqueue_enqueue_n(b->queue, batch, b->batch - j);
+      if (!k) {
+        sched_yield();
+      }
+      j += k;
+    }
+  }
+  return NULL;
+}
+
+void* consume(void* arg) {
+  struct bench* b = arg;
+  void* batch[BATCH];
+  int i = 0, j;
+  while (i < NUM_MESSAGES) {
+    int k = b->batch == 1 ? spscqueue_dequeue(b->queue) != NULL
+      : spscqueue_dequeue_n(b->queue, batch, b->batch);
+    for (j = 0; b->batch > 1 && j < k; j++) {
+      if (batch[j] != &message) {
+        abort();
+      }
+    }
+    if (!k) {
+      sched_yield();
+    }
+    i += k;
+  }
+  return NULL;
+}
+
+/*
+ * Runs a producer and a consumer and returns the throughput in millions of
+ * messages per second.
+ */
+double measure(void* (*producer)(void*), void* (*consumer)(void*),
+    struct bench* b) {
+  pthread_t p, c;
+  struct timespec start, end;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  pthread_create(&p, NULL, producer, b);
+  pthread_create(&c, NULL, consumer, b);
+  pthread_join(p, NULL);
+  pthread_join(c, NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double secs = (end.tv_sec - start.tv_sec)
+    + (end.tv_nsec - start.tv_nsec) / 1e9;
+  return NUM_MESSAGES / secs / 1e6;
+}
+
+int main(int argc, char** argv) {
+  struct bench b;
+
+  b.da = dynarray_create();
+  pthread_mutex_init(&b.lock, NULL);
+  printf("%-24s %9.1f M/s\n", "mutex + dynarray",
+    measure(produce_locked, consume_locked, &b));
+  pthread_mutex_destroy(&b.lock);
+  dynarray_free(b.da);
+
+  b.queue = spscqueue_create(CAPACITY);
+  b.batch = 1;
+  printf("%-24s %9.1f M/s\n", "spscqueue",
+    measure(produce, consume, &b));
+  b.batch = BATCH;
+  printf("%-24s %9.1f M/s\n", "spscqueue, batches of 64",
+    measure(produce, consume, &b));
+  spscqueue_free(b.queue);
+  return 0;
+}
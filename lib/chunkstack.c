@@ -0,0 +1,133 @@
+/*
+ * This file contains the out-of-line parts of the chunked stack whose
+ * interface is defined in chunkstack.h.  Pushing, popping and reading the
+ * top of the stack are inlined from chunkstack.h; this file handles moving
+ * from one chunk to the next.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "chunkstack.h"
+
+/*
+ * The number of values in a stack's first chunk, and the most values in any
+ * chunk.  Each chunk is twice as big as the one below it, up to the maximum.
+ */
+#define CHUNKSTACK_MIN 16
+#define CHUNKSTACK_MAX 4096
+
+/*
+ * This function initializes an empty chunked stack.  No memory is allocated
+ * until the first value is pushed.
+ *
+ * Params:
+ *   cs - the chunked stack to initialize.  May not be NULL.
+ */
+void chunkstack_init(struct chunkstack* cs) {
+  assert(cs);
+  cs->chunk = NULL;
+  cs->top = 0;
+  cs->size = 0;
+  cs->spare = NULL;
+}
+
+/*
+ * This function frees the memory used by a chunked stack.  Freeing any memory
+ * associated with values still stored in the stack is the responsibility of
+ * the caller.  The stack may be used again after calling chunkstack_init().
+ *
+ * Params:
+ *   cs - the chunked stack to destroy.  May not be NULL.
+ */
+void chunkstack_destroy(struct chunkstack* cs) {
+  assert(cs);
+
+  struct chunkstack_chunk* below, * curr = cs->chunk;
+  while (curr) {
+    below = curr->below;
+    free(curr);
+    curr = below;
+  }
+  free(cs->spare);
+  chunkstack_init(cs);
+}
+
+/*
+ * Auxilliary function, called by chunkstack_push(), to put a new, empty chunk
+ * on top of a stack whose top chunk is full (or that has no chunks yet).  The
+ * spare chunk is used if there is one.
+ */
+void _chunkstack_grow(struct chunkstack* cs) {
+  struct chunkstack_chunk* chunk = cs->spare;
+  if (chunk) {
+    cs->spare = NULL;
+  } else {
+    int capacity = CHUNKSTACK_MIN;
+    if (cs->chunk) {
+      capacity = 2 * cs->chunk->capacity;
+      if (capacity > CHUNKSTACK_MAX) {
+        capacity = CHUNKSTACK_MAX;
+      }
+    }
+    chunk = malloc(sizeof(struct chunkstack_chunk)
+      + capacity * sizeof(void*));
+    assert(chunk);
+    chunk->capacity = capacity;
+  }
+
+  chunk->below = cs->chunk;
+  cs->chunk = chunk;
+  cs->top = 0;
+}
+
+/*
+ * Auxilliary function, called by chunkstack_pop(), to take the empty top
+ * chunk off a stack and make the (full) chunk below it the top chunk.  The
+ * empty chunk is kept as the spare, in place of any older spare.
+ */
+void _chunkstack_shrink(struct chunkstack* cs) {
+  struct chunkstack_chunk* empty = cs->chunk;
+  free(cs->spare);
+  cs->spare = empty;
+  cs->chunk = empty->below;
+  cs->top = cs->chunk->capacity;
+}
+
+/*
+ * This function discards every value above a checkpoint taken with
+ * chunkstack_mark(), leaving the stack exactly as it was when the checkpoint
+ * was taken.  The values themselves are never touched: whole chunks above
+ * the checkpoint are dropped at once, and the new top chunk is cut back by
+ * moving its top, so this takes time proportional to the number of chunks
+ * dropped rather than the number of values.  The lowest chunk dropped is
+ * kept as the spare, since it is the one the next push past the new top
+ * chunk would allocate.  Freeing any memory associated with the discarded
+ * values is the responsibility of the caller.
+ *
+ * Params:
+ *   cs - the chunked stack to roll back.  May not be NULL.
+ *   mark - the checkpoint to roll back to.  Must be no larger than the
+ *     current size of the stack.
+ */
+void chunkstack_rollback(struct chunkstack* cs, int mark) {
+  assert(cs);
+  assert(mark >= 0 && mark <= cs->size);
+
+  struct chunkstack_chunk* dropped = NULL;
+  while (cs->chunk && cs->chunk->below && cs->size - cs->top >= mark) {
+    struct chunkstack_chunk* chunk = cs->chunk;
+    cs->size -= cs->top;
+    cs->chunk = chunk->below;
+    cs->top = cs->chunk->capacity;
+    free(dropped);
+    dropped = chunk;
+  }
+
+  if (dropped) {
+    free(cs->spare);
+    cs->spare = dropped;
+  }
+  cs->top -= cs->size - mark;
+  cs->size = mark;
+}
@@ -0,0 +1,133 @@
+/*
+ * This file contains the definition of the interface for a chunked stack: a
+ * stack of void* values stored in arrays ("chunks") linked from the top
+ * chunk down.  When the top chunk fills up, a new one is linked on top of it,
+ * so values are never copied as the stack grows, and pushing and popping
+ * only allocate or free memory when the stack crosses into a new chunk.
+ * You can find descriptions of the out-of-line functions in chunkstack.c.
+ */
+
+#ifndef __CHUNKSTACK_H
+#define __CHUNKSTACK_H
+
+#include <stddef.h>
+#include <assert.h>
+
+/*
+ * Structure used to represent one chunk of a chunked stack.
+ */
+struct chunkstack_chunk {
+  struct chunkstack_chunk* below;
+  int capacity;
+  void* vals[];
+};
+
+/*
+ * Structure used to represent a chunked stack.  The values are the first
+ * `top` values of `chunk`, on top of all of the values in the chunks below
+ * it.  `spare` is an empty chunk kept after the stack shrinks out of it, so
+ * pushing and popping back and forth across the end of a chunk doesn't keep
+ * allocating and freeing it.
+ *
+ * Unlike most of the structures in this library, a chunked stack is meant to
+ * be embedded in another structure (or declared on the stack), so its fields
+ * are defined here, and it is set up with chunkstack_init() instead of being
+ * allocated by a create function.  The fields are also visible so the push,
+ * pop and top functions below can be inlined into their callers.  Use the
+ * functions rather than accessing the fields directly.
+ */
+struct chunkstack {
+  struct chunkstack_chunk* chunk;
+  int top;
+  int size;
+  struct chunkstack_chunk* spare;
+};
+
+/*
+ * Chunked stack interface function prototypes.  Refer to chunkstack.c for
+ * documentation about each of these functions.
+ */
+void chunkstack_init(struct chunkstack* cs);
+void chunkstack_destroy(struct chunkstack* cs);
+void _chunkstack_grow(struct chunkstack* cs);
+void _chunkstack_shrink(struct chunkstack* cs);
+void chunkstack_rollback(struct chunkstack* cs, int mark);
+
+/*
+ * This function returns 1 if a given chunked stack is empty and 0 otherwise.
+ */
+static inline int chunkstack_isempty(struct chunkstack* cs) {
+  assert(cs);
+  return cs->size == 0;
+}
+
+/*
+ * This function returns the number of values in a given chunked stack.
+ */
+static inline int chunkstack_size(struct chunkstack* cs) {
+  assert(cs);
+  return cs->size;
+}
+
+/*
+ * This function returns a checkpoint of a given chunked stack, to be passed to
+ * chunkstack_rollback() later to discard every value pushed since.  A
+ * checkpoint is just the number of values in the stack, so it stays valid as
+ * long as the stack never gets smaller than it was when the checkpoint was
+ * taken.
+ */
+static inline int chunkstack_mark(struct chunkstack* cs) {
+  assert(cs);
+  return cs->size;
+}
+
+/*
+ * This function pushes a value onto a given chunked stack.
+ *
+ * Params:
+ *   cs - the chunked stack onto which to push a value.  May not be NULL.
+ *   val - the value to be pushed.
+ */
+static inline void chunkstack_push(struct chunkstack* cs, void* val) {
+  assert(cs);
+  if (!cs->chunk || cs->top == cs->chunk->capacity) {
+    _chunkstack_grow(cs);
+  }
+  cs->chunk->vals[cs->top++] = val;
+  cs->size++;
+}
+
+/*
+ * This function returns the value at the top of a given chunked stack without
+ * removing it, or NULL if the stack is empty.
+ *
+ * Params:
+ *   cs - the chunked stack whose top value is to be returned.  May not be
+ *     NULL.
+ */
+static inline void* chunkstack_top(struct chunkstack* cs) {
+  assert(cs);
+  return cs->size ? cs->chunk->vals[cs->top - 1] : NULL;
+}
+
+/*
+ * This function pops the value at the top of a given chunked stack and
+ * returns it, or returns NULL if the stack is empty.
+ *
+ * Params:
+ *   cs - the chunked stack from which to pop a value.  May not be NULL.
+ */
+static inline void* chunkstack_pop(struct chunkstack* cs) {
+  assert(cs);
+  if (!cs->size) {
+    return NULL;
+  }
+  void* val = cs->chunk->vals[--cs->top];
+  cs->size--;
+  if (cs->top == 0 && cs->chunk->below) {
+    _chunkstack_shrink(cs);
+  }
+  return val;
+}
+
+#endif
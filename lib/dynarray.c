@@ -0,0 +1,739 @@
+/*
+ * This file contains a simple implementation of a dynamic array.  See the
+ * documentation below for more information on the individual functions in
+ * this implementation.
+ *
+ * The elements are kept in a circular buffer, so elements can be inserted and
+ * removed at either end of the array in O(1) time, which lets the array be
+ * used as a queue or a deque.  Small arrays keep their elements inline, in
+ * the same allocation as the array itself.  On Linux, once an array's storage reaches
+ * DYNARRAY_MMAP_THRESHOLD bytes it is allocated directly with mmap(), and
+ * growing it uses mremap(), which lets the kernel move the pages to a bigger
+ * mapping instead of copying them.  Compile with -DDYNARRAY_HUGEPAGES to also
+ * ask for transparent huge pages for those mappings.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sys/mman.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "dynarray.h"
+#include "dynarray_scan.h"
+#include "dynarray_sort.h"
+
+#define DYNARRAY_INIT_CAPACITY 8
+
+/*
+ * The storage size, in bytes, at and above which a separately allocated
+ * storage array is mapped with mmap() instead of allocated with malloc().
+ */
+#define DYNARRAY_MMAP_THRESHOLD (1 << 20)
+
+/*
+ * Auxilliary function that returns 1 if a separately allocated storage array
+ * with the given capacity is mapped with mmap() and 0 if it comes from
+ * malloc().
+ */
+static int _dynarray_is_mapped(int capacity) {
+#ifdef __linux__
+  return (size_t)capacity * sizeof(void*) >= DYNARRAY_MMAP_THRESHOLD;
+#else
+  return 0;
+#endif
+}
+
+/*
+ * Auxilliary function to allocate a separate storage array with room for
+ * `capacity` elements.
+ */
+static void** _dynarray_alloc(int capacity) {
+  size_t bytes = (size_t)capacity * sizeof(void*);
+  void** data;
+#ifdef __linux__
+  if (_dynarray_is_mapped(capacity)) {
+    data = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(data != MAP_FAILED);
+#ifdef DYNARRAY_HUGEPAGES
+    madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+    return data;
+  }
+#endif
+  data = malloc(bytes);
+  assert(data);
+  return data;
+}
+
+/*
+ * Auxilliary function to free a storage array allocated by _dynarray_alloc().
+ */
+static void _dynarray_release(void** data, int capacity) {
+#ifdef __linux__
+  if (_dynarray_is_mapped(capacity)) {
+    munmap(data, (size_t)capacity * sizeof(void*));
+    return;
+  }
+#endif
+  free(data);
+}
+
+/*
+ * This function allocates and initializes a new, empty dynamic array that
+ * can hold `capacity` elements before it needs to allocate any more memory,
+ * and returns a pointer to it.  The array and its storage are allocated
+ * together in a single block.
+ *
+ * Params:
+ *   capacity - the number of elements to make room for.  Must be positive.
+ */
+struct dynarray* dynarray_create_with_capacity(int capacity) {
+  assert(capacity > 0);
+
+  struct dynarray* da = malloc(sizeof(struct dynarray)
+    + (size_t)capacity * sizeof(void*));
+  assert(da);
+
+  da->data = da->inline_data;
+  da->size = 0;
+  da->capacity = capacity;
+  da->head = 0;
+  da->inline_capacity = capacity;
+
+  return da;
+}
+
+/*
+ * This function allocates and initializes a new, empty dynamic array and
+ * returns a pointer to it.  Its first DYNARRAY_INIT_CAPACITY elements are
+ * stored inline, in the same allocation as the array itself.
+ */
+struct dynarray* dynarray_create() {
+  return dynarray_create_with_capacity(DYNARRAY_INIT_CAPACITY);
+}
+
+/*
+ * This function frees the memory associated with a dynamic array. Freeing
+ * any memory associated with values stored in the array is the responsibility
+ * of the caller. 
+ *
+ * Params:
+ *   da - the dynamic array to be destroyed.  May not be NULL.
+ */
+void dynarray_free(struct dynarray* da) {
+  assert(da);
+  if (da->data != da->inline_data) {
+    _dynarray_release(da->data, da->capacity);
+  }
+  free(da);
+}
+
+/*
+ * Auxilliary function to reverse the slots data[lo..hi).
+ */
+static void _dynarray_reverse(void** data, int lo, int hi) {
+  for (hi--; lo < hi; lo++, hi--) {
+    void* tmp = data[lo];
+    data[lo] = data[hi];
+    data[hi] = tmp;
+  }
+}
+
+/*
+ * Auxilliary function to rotate a dynamic array's circular buffer in place
+ * so that the element at index 0 is in slot 0 and the elements are stored
+ * contiguously.  Functions that work on a block of elements at once call
+ * this first.  It does nothing (and costs nothing) unless elements have been
+ * removed from or inserted at the front of the array.
+ */
+static void _dynarray_linearize(struct dynarray* da) {
+  if (da->head == 0) {
+    return;
+  }
+
+  if (da->head + da->size <= da->capacity) {
+    memmove(da->data, da->data + da->head, da->size * sizeof(void*));
+  } else {
+    _dynarray_reverse(da->data, 0, da->head);
+    _dynarray_reverse(da->data, da->head, da->capacity);
+    _dynarray_reverse(da->data, 0, da->capacity);
+  }
+  da->head = 0;
+}
+
+/*
+ * Auxilliary function that returns how many of a dynamic array's elements
+ * are stored from slot `head` to the end of the storage array.  The rest, if
+ * any, have wrapped around to the start of the storage array.
+ */
+static int _dynarray_first_run(struct dynarray* da) {
+  int first = da->capacity - da->head;
+  return first < da->size ? first : da->size;
+}
+
+/*
+ * Auxilliary function to perform a resize on a dynamic array's underlying
+ * storage array.  If the new capacity fits in the array's inline storage,
+ * the elements are moved back there.  The elements end up contiguous,
+ * starting at slot 0.
+ */
+void _dynarray_resize(struct dynarray* da, int new_capacity) {
+  assert(new_capacity >= da->size && new_capacity > 0);
+  _dynarray_linearize(da);
+  int was_inline = da->data == da->inline_data;
+  void** new_data;
+
+  if (new_capacity <= da->inline_capacity) {
+    if (!was_inline) {
+      memcpy(da->inline_data, da->data, da->size * sizeof(void*));
+      _dynarray_release(da->data, da->capacity);
+      da->data = da->inline_data;
+    }
+    da->capacity = da->inline_capacity;
+    return;
+  }
+
+#ifdef __linux__
+  if (!was_inline && _dynarray_is_mapped(da->capacity)
+      && _dynarray_is_mapped(new_capacity)) {
+    /*
+     * Remap the pages of the old array into a mapping of the new size.  No
+     * data is copied.
+     */
+    size_t new_bytes = (size_t)new_capacity * sizeof(void*);
+    new_data = mremap(da->data, (size_t)da->capacity * sizeof(void*),
+      new_bytes, MREMAP_MAYMOVE);
+    assert(new_data != MAP_FAILED);
+#ifdef DYNARRAY_HUGEPAGES
+    madvise(new_data, new_bytes, MADV_HUGEPAGE);
+#endif
+    da->data = new_data;
+    da->capacity = new_capacity;
+    return;
+  }
+#endif
+
+  if (was_inline || _dynarray_is_mapped(da->capacity)
+      || _dynarray_is_mapped(new_capacity)) {
+    /*
+     * The data is moving out of the inline storage or crossing the mmap()
+     * threshold, so it has to be copied into a new storage array.
+     */
+    new_data = _dynarray_alloc(new_capacity);
+    memcpy(new_data, da->data, da->size * sizeof(void*));
+    if (!was_inline) {
+      _dynarray_release(da->data, da->capacity);
+    }
+  } else {
+    /*
+     * Reallocate the underlying array.  This copies the data from the old
+     * array to the new one only if it can't be resized in place.
+     */
+    new_data = realloc(da->data, new_capacity * sizeof(void*));
+    assert(new_data);
+  }
+
+  /*
+   * Put the new array into the dynarray struct.
+   */
+  da->data = new_data;
+  da->capacity = new_capacity;
+}
+
+/*
+ * Auxilliary function to make sure a dynamic array has room for at least
+ * `min_capacity` elements, doubling its capacity as many times as needed so
+ * that it is resized at most once.
+ */
+void _dynarray_grow(struct dynarray* da, int min_capacity) {
+  int new_capacity = da->capacity;
+  while (new_capacity < min_capacity) {
+    new_capacity *= 2;
+  }
+  if (new_capacity != da->capacity) {
+    _dynarray_resize(da, new_capacity);
+  }
+}
+
+/*
+ * This function makes sure a given dynamic array can hold at least `capacity`
+ * elements without being resized.  Calling this before inserting a known
+ * number of elements means the array's storage is allocated just once.  If
+ * the array's capacity is already big enough, this function does nothing.
+ *
+ * Params:
+ *   da - the dynamic array whose capacity is to be reserved.  May not be NULL.
+ *   capacity - the number of elements the array should be able to hold.
+ */
+void dynarray_reserve(struct dynarray* da, int capacity) {
+  assert(da);
+
+  if (capacity > da->capacity) {
+    _dynarray_resize(da, capacity);
+  }
+}
+
+/*
+ * This function releases any unused capacity in a given dynamic array, so
+ * its capacity matches its size (an empty array keeps room for one element).
+ *
+ * Params:
+ *   da - the dynamic array to be shrunk.  May not be NULL.
+ */
+void dynarray_shrink_to_fit(struct dynarray* da) {
+  assert(da);
+
+  int new_capacity = da->size > 0 ? da->size : 1;
+  if (new_capacity != da->capacity) {
+    _dynarray_resize(da, new_capacity);
+  }
+}
+
+/*
+ * This function inserts a new value to a given dynamic array.  The new element
+ * is always inserted at the *end* of the array.
+ *
+ * Params:
+ *   da - the dynamic array into which to insert an element.  May not be NULL.
+ *   val - the value to be inserted.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void dynarray_insert(struct dynarray* da, void* val) {
+  assert(da);
+
+  /*
+   * Make sure we have enough space for the new element.  Resize if needed.
+   */
+  if (da->size == da->capacity) {
+    _dynarray_resize(da, 2 * da->capacity);
+  }
+
+  /*
+   * Put the new element at the end of the array.
+   */
+  da->data[_dynarray_slot(da, da->size)] = val;
+  da->size++;
+}
+
+/*
+ * This function inserts a new value at the *front* of a given dynamic array,
+ * so that it becomes the element at index 0.  Because the array is stored as
+ * a circular buffer, this only moves the head back by one slot and has O(1)
+ * average runtime complexity.
+ *
+ * Params:
+ *   da - the dynamic array into which to insert an element.  May not be NULL.
+ *   val - the value to be inserted.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void dynarray_insert_front(struct dynarray* da, void* val) {
+  assert(da);
+
+  if (da->size == da->capacity) {
+    _dynarray_resize(da, 2 * da->capacity);
+  }
+
+  da->head = da->head == 0 ? da->capacity - 1 : da->head - 1;
+  da->data[da->head] = val;
+  da->size++;
+}
+
+/*
+ * This function inserts `n` values from a caller-supplied array at the end of
+ * a given dynamic array, in order.  The array is resized at most once, and
+ * the values are copied into the circular buffer where they belong with at
+ * most two memcpy()s (two if they wrap around the end of the buffer), so
+ * an array used as a queue is never rotated.
+ *
+ * Params:
+ *   da - the dynamic array into which to insert the values.  May not be NULL.
+ *   vals - the values to be inserted.  May be NULL only if `n` is 0.
+ *   n - the number of values in `vals`.
+ */
+void dynarray_append_n(struct dynarray* da, void** vals, int n) {
+  assert(da);
+  assert(n >= 0);
+
+  if (n == 0) {
+    return;
+  }
+
+  _dynarray_grow(da, da->size + n);
+  int tail = _dynarray_slot(da, da->size);
+  int first = da->capacity - tail < n ? da->capacity - tail : n;
+  memcpy(da->data + tail, vals, first * sizeof(void*));
+  memcpy(da->data, vals + first, (n - first) * sizeof(void*));
+  da->size += n;
+}
+
+/*
+ * This function inserts `n` values from a caller-supplied array into a given
+ * dynamic array, so that the first of them ends up at index `idx`.  Existing
+ * elements from `idx` on are moved back `n` places in a single memmove().
+ *
+ * Params:
+ *   da - the dynamic array into which to insert the values.  May not be NULL.
+ *   idx - the index at which to insert the values.  The value of `idx` must
+ *     be between 0 and n (both inclusive), where n is the number of elements
+ *     stored in the array.
+ *   vals - the values to be inserted.  May be NULL only if `n` is 0.
+ *   n - the number of values in `vals`.
+ */
+void dynarray_insert_range(struct dynarray* da, int idx, void** vals, int n) {
+  assert(da);
+  assert(idx <= da->size && idx >= 0);
+  assert(n >= 0);
+
+  if (n == 0) {
+    return;
+  }
+
+  _dynarray_grow(da, da->size + n);
+  _dynarray_linearize(da);
+  memmove(da->data + idx + n, da->data + idx, (da->size - idx) * sizeof(void*));
+  memcpy(da->data + idx, vals, n * sizeof(void*));
+  da->size += n;
+}
+
+/*
+ * This function removes the element at the front of a given dynamic array
+ * (i.e. the one at index 0) and returns it.  This has O(1) runtime
+ * complexity.
+ *
+ * Params:
+ *   da - the dynamic array from which to remove an element.  May not be NULL
+ *     or empty.
+ *
+ * Return:
+ *   This function returns the value that was removed.
+ */
+void* dynarray_remove_front(struct dynarray* da) {
+  assert(da);
+  assert(da->size > 0);
+
+  void* val = da->data[da->head];
+  da->head = _dynarray_slot(da, 1);
+  da->size--;
+  return val;
+}
+
+/*
+ * This function removes up to `n` elements from the front of a given dynamic
+ * array, copying them in order into a caller-supplied array.  Like
+ * dynarray_remove_front(), this only advances the head of the circular
+ * buffer; the elements are copied out with at most two memcpy()s.
+ *
+ * Params:
+ *   da - the dynamic array from which to remove elements.  May not be NULL.
+ *   vals - the array into which to copy the removed elements.  Must have
+ *     room for `n` values, and may be NULL only if `n` is 0.
+ *   n - the most elements to remove.
+ *
+ * Return:
+ *   This function returns the number of elements removed, which is less than
+ *   `n` if the array had fewer than `n` elements.
+ */
+int dynarray_remove_front_n(struct dynarray* da, void** vals, int n) {
+  assert(da);
+  assert(n >= 0);
+
+  if (n > da->size) {
+    n = da->size;
+  }
+  if (n == 0) {
+    return 0;
+  }
+
+  int first = da->capacity - da->head < n ? da->capacity - da->head : n;
+  memcpy(vals, da->data + da->head, first * sizeof(void*));
+  memcpy(vals + first, da->data, (n - first) * sizeof(void*));
+  da->head = _dynarray_slot(da, n);
+  da->size -= n;
+  return n;
+}
+
+/*
+ * This function removes the element at the end of a given dynamic array
+ * (i.e. the one at index n-1) and returns it.  This has O(1) runtime
+ * complexity.
+ *
+ * Params:
+ *   da - the dynamic array from which to remove an element.  May not be NULL
+ *     or empty.
+ *
+ * Return:
+ *   This function returns the value that was removed.
+ */
+void* dynarray_remove_end(struct dynarray* da) {
+  assert(da);
+  assert(da->size > 0);
+
+  da->size--;
+  return da->data[_dynarray_slot(da, da->size)];
+}
+
+/*
+ * This function removes an element at a specified index from a dynamic array.
+ * All existing elements following the specified index are moved forward to
+ * fill in the gap left by the removed element.  Since the array is circular,
+ * this is done by shifting whichever side of `idx` is shorter, so removing
+ * from either end is O(1).
+ *
+ * Params:
+ *   da - the dynamic array from which to remove an element.  May not be NULL.
+ *   idx - the index of the element to be removed.  The value of `idx` must be
+ *     between 0 (inclusive) and n (exclusive), where n is the number of
+ *     elements stored in the array.
+ */
+void dynarray_remove(struct dynarray* da, int idx) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  if (idx < da->size / 2) {
+    /*
+     * Move all elements in front of the one being removed back one index,
+     * then advance the head past the now unused first slot.
+     */
+    for (int i = idx; i > 0; i--) {
+      da->data[_dynarray_slot(da, i)] = da->data[_dynarray_slot(da, i - 1)];
+    }
+    dynarray_remove_front(da);
+  } else {
+    /*
+     * Move all elements behind the one being removed forward one index,
+     * overwriting the element to be removed in the process.
+     */
+    for (int i = idx; i < da->size - 1; i++) {
+      da->data[_dynarray_slot(da, i)] = da->data[_dynarray_slot(da, i + 1)];
+    }
+    dynarray_remove_end(da);
+  }
+}
+
+/*
+ * This function returns the index of the first element of a dynamic array
+ * that matches a specified value, or -1 if no element matches.  This function
+ * is passed a function pointer `cmp` that is used to compare `val` with the
+ * values stored in the array, just like list_position().  If `cmp` is NULL,
+ * values are compared as pointers, which is done with vector instructions
+ * where the CPU supports them.
+ *
+ * Params:
+ *   da - the dynamic array to search.  May not be NULL.
+ *   val - the value to search for.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them for equality.  If the two values passed are to be
+ *     considered equal, this function should return 0.  Otherwise, it should
+ *     return a non-zero value.  May be NULL.
+ *
+ * Return:
+ *   This function returns the index of the first matching element of `da`,
+ *   or -1 if no element matches.
+ */
+int dynarray_find(struct dynarray* da, void* val,
+    int (*cmp)(void* a, void* b)) {
+  assert(da);
+
+  if (!cmp) {
+    /*
+     * Scan the part of the circular buffer from the head to the end of the
+     * storage array, then the part that wrapped around to its start.
+     */
+    int first = _dynarray_first_run(da);
+    int idx = dynarray_scan_find_ptr(da->data + da->head, first, val);
+    if (idx >= 0) {
+      return idx;
+    }
+    idx = dynarray_scan_find_ptr(da->data, da->size - first, val);
+    return idx < 0 ? -1 : first + idx;
+  }
+
+  for (int i = 0; i < da->size; i++) {
+    if (cmp(val, da->data[_dynarray_slot(da, i)]) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*
+ * This function returns the number of elements of a dynamic array that match
+ * a specified value.  Elements are compared with `cmp` exactly as in
+ * dynarray_find().
+ *
+ * Params:
+ *   da - the dynamic array to search.  May not be NULL.
+ *   val - the value to count.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them for equality, as described above.  May be NULL.
+ */
+int dynarray_count(struct dynarray* da, void* val,
+    int (*cmp)(void* a, void* b)) {
+  assert(da);
+
+  if (!cmp) {
+    int first = _dynarray_first_run(da);
+    return dynarray_scan_count_ptr(da->data + da->head, first, val)
+      + dynarray_scan_count_ptr(da->data, da->size - first, val);
+  }
+
+  int count = 0;
+  for (int i = 0; i < da->size; i++) {
+    count += cmp(val, da->data[_dynarray_slot(da, i)]) == 0;
+  }
+  return count;
+}
+
+/*
+ * This function removes every element of a dynamic array for which a
+ * predicate returns a non-zero value.  The remaining elements keep their
+ * order, and the array is compacted in place in a single pass over the
+ * circular buffer, so this is much faster than calling dynarray_remove()
+ * once for each element to be removed.
+ *
+ * Params:
+ *   da - the dynamic array from which to remove elements.  May not be NULL.
+ *   pred - pointer to a function that is passed each element of the array,
+ *     in order, along with `ctx`.  If the element should be removed, this
+ *     function should return a non-zero value.  Otherwise, it should return
+ *     0.  May not be NULL.
+ *   ctx - a pointer passed unchanged to every call to `pred`.
+ *
+ * Return:
+ *   This function returns the number of elements that were removed.
+ */
+int dynarray_remove_if(struct dynarray* da, int (*pred)(void* val, void* ctx),
+    void* ctx) {
+  assert(da && pred);
+
+  /*
+   * Nothing needs to move until the first element to be removed, so find
+   * that first.
+   */
+  int kept = 0;
+  while (kept < da->size && !pred(da->data[_dynarray_slot(da, kept)], ctx)) {
+    kept++;
+  }
+
+  /*
+   * Copy each element down to the end of the kept elements, and only count it
+   * as kept if it isn't to be removed.  This avoids a branch per element.
+   */
+  for (int i = kept + 1; i < da->size; i++) {
+    void* elem = da->data[_dynarray_slot(da, i)];
+    da->data[_dynarray_slot(da, kept)] = elem;
+    kept += !pred(elem, ctx);
+  }
+
+  int removed = da->size - kept;
+  da->size = kept;
+  return removed;
+}
+
+/*
+ * This structure is used to pass a value and a comparison function from
+ * dynarray_remove_all() to _dynarray_matches().
+ */
+struct _dynarray_match {
+  void* val;
+  int (*cmp)(void* a, void* b);
+};
+
+/*
+ * Auxilliary function used as the predicate for dynarray_remove_if() by
+ * dynarray_remove_all().
+ */
+static int _dynarray_matches(void* elem, void* ctx) {
+  struct _dynarray_match* match = ctx;
+  if (match->cmp) {
+    return match->cmp(match->val, elem) == 0;
+  }
+  return elem == match->val;
+}
+
+/*
+ * This function removes every element of a dynamic array that matches a
+ * specified value.  Elements are compared with `cmp` exactly as in
+ * dynarray_find(), and removed with dynarray_remove_if(), so the remaining
+ * elements keep their order.
+ *
+ * Params:
+ *   da - the dynamic array from which to remove elements.  May not be NULL.
+ *   val - the value to be removed.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them for equality, as described above.  May be NULL.
+ *
+ * Return:
+ *   This function returns the number of elements that were removed.
+ */
+int dynarray_remove_all(struct dynarray* da, void* val,
+    int (*cmp)(void* a, void* b)) {
+  assert(da);
+  struct _dynarray_match match = { val, cmp };
+  return dynarray_remove_if(da, _dynarray_matches, &match);
+}
+
+/*
+ * This function sorts the elements of a dynamic array into ascending order,
+ * as defined by a comparison function.  Arrays of up to
+ * DYNARRAY_SORT_PARALLEL_MIN elements are sorted with an introsort on the
+ * calling thread; larger arrays are sorted on multiple threads (see
+ * dynarray_sort.c).  The sort is not stable.
+ *
+ * Params:
+ *   da - the dynamic array to sort.  May not be NULL.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them.  It should return a negative value if the first should
+ *     come before the second, a positive value if it should come after, and
+ *     0 if they are equivalent.  May not be NULL.
+ */
+void dynarray_sort(struct dynarray* da, int (*cmp)(void* a, void* b)) {
+  assert(da);
+  assert(cmp);
+
+  _dynarray_linearize(da);
+  dynarray_sort_ptrs(da->data, da->size, cmp);
+}
+
+/*
+ * This function prints out all spots (from 0 to capacity) in a dynamic array.
+ * If the spot does not have an element, print NULL.
+ *
+ * Params:
+ *   da - the dynamic array from which to print.  May not be NULL.
+ *   void (*p) (void* a) - a function pointer to print an element within the queue
+ * 
+ * Return:
+ *   none.
+ */
+void dynarray_print(struct dynarray* da, void (*p) (void* a)){
+  assert(da);
+  assert(da->data);
+
+  for (int i = 0; i < da->capacity; ++i)
+  {
+    printf("%d: ", i);
+    /*
+     * Slot i holds an element only if it's within `size` slots of the head.
+     */
+    int idx = i - da->head;
+    if (idx < 0) {
+      idx += da->capacity;
+    }
+    if (idx >= da->size || da->data[i] == NULL){
+      printf("NULL\n");
+      continue;
+    }
+    p(da->data[i]);
+
+  }
+
+  return;
+
+}
@@ -0,0 +1,119 @@
+/*
+ * This file contains the definition of the interface for a dynamic array.
+ * You can find descriptions of the dynamic array functions, including their
+ * parameters and their return values, in dynarray.c.
+ *
+ */
+
+#ifndef __DYNARRAY_H
+#define __DYNARRAY_H
+
+#include <assert.h>
+
+/*
+ * Structure used to represent a dynamic array.  The elements are stored in a
+ * circular buffer: the element at index 0 is in slot `head` of `data`, and
+ * indices past the end of `data` wrap around to its start.  The struct and
+ * its first `inline_capacity` slots (`inline_data`) are allocated together
+ * as one block, so a small array needs just one allocation; `data` points at
+ * `inline_data` until the array outgrows it.
+ *
+ * The fields are defined here only so that dynarray_size(), dynarray_get()
+ * and dynarray_set() can be inlined into their callers.  Use the functions
+ * below rather than accessing the fields directly.
+ */
+struct dynarray {
+  void** data;
+  int size;
+  int capacity;
+  int head;
+  int inline_capacity;
+  void* inline_data[];
+};
+
+/*
+ * Dynamic array interface function prototypes.  Refer to dynarray.c for
+ * documentation about each of these functions.
+ */
+struct dynarray* dynarray_create();
+struct dynarray* dynarray_create_with_capacity(int capacity);
+void dynarray_free(struct dynarray* da);
+void dynarray_insert(struct dynarray* da, void* val);
+void dynarray_insert_front(struct dynarray* da, void* val);
+void dynarray_append_n(struct dynarray* da, void** vals, int n);
+void dynarray_insert_range(struct dynarray* da, int idx, void** vals, int n);
+void dynarray_reserve(struct dynarray* da, int capacity);
+void dynarray_shrink_to_fit(struct dynarray* da);
+void dynarray_remove(struct dynarray* da, int idx);
+void* dynarray_remove_front(struct dynarray* da);
+int dynarray_remove_front_n(struct dynarray* da, void** vals, int n);
+void* dynarray_remove_end(struct dynarray* da);
+int dynarray_find(struct dynarray* da, void* val,
+    int (*cmp)(void* a, void* b));
+int dynarray_count(struct dynarray* da, void* val,
+    int (*cmp)(void* a, void* b));
+int dynarray_remove_if(struct dynarray* da, int (*pred)(void* val, void* ctx),
+    void* ctx);
+int dynarray_remove_all(struct dynarray* da, void* val,
+    int (*cmp)(void* a, void* b));
+void dynarray_sort(struct dynarray* da, int (*cmp)(void* a, void* b));
+void dynarray_print(struct dynarray* da, void (*p) (void* a));
+
+/*
+ * Auxilliary function to map an index (0 is the front of the array) to a
+ * slot in the circular buffer.  This is cheaper than taking the index
+ * modulo the capacity, since `head + idx` can never wrap more than once.
+ */
+static inline int _dynarray_slot(struct dynarray* da, int idx) {
+  int slot = da->head + idx;
+  if (slot >= da->capacity) {
+    slot -= da->capacity;
+  }
+  return slot;
+}
+
+/*
+ * This function returns the size of a given dynamic array (i.e. the number of
+ * elements stored in it, not the capacity).
+ */
+static inline int dynarray_size(struct dynarray* da) {
+  assert(da);
+  return da->size;
+}
+
+/*
+ * This function returns the value of an existing element in a dynamic array.
+ *
+ * Params:
+ *   da - the dynamic array from which to get a value.  May not be NULL.
+ *   idx - the index of the element whose value should be returned.  The value
+ *     of `idx` must be between 0 (inclusive) and n (exclusive), where n is the
+ *     number of elements stored in the array.
+ */
+static inline void* dynarray_get(struct dynarray* da, int idx) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  return da->data[_dynarray_slot(da, idx)];
+}
+
+/*
+ * This function updates (i.e. overwrites) the value of an existing element in
+ * a dynamic array.
+ *
+ * Params:
+ *   da - the dynamic array in which to set a value.  May not be NULL.
+ *   idx - the index of the element whose value should be updated.  The value
+ *     of `idx` must be between 0 (inclusive) and n (exclusive), where n is the
+ *     number of elements stored in the array.
+ *   val - the new value to be set.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+static inline void dynarray_set(struct dynarray* da, int idx, void* val) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  da->data[_dynarray_slot(da, idx)] = val;
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * This file contains the search kernels used by the dynamic arrays to find
+ * and count elements equal to a key.  On x86 machines, each kernel has an
+ * SSE2 version and an AVX2 version.  When the program starts, it checks which
+ * instructions the CPU supports and picks the best version for every call
+ * after that.  Every kernel also has a plain scalar version, which is used
+ * on other machines and returns exactly the same results.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#include "dynarray_scan.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DYNARRAY_SCAN_X86
+#include <immintrin.h>
+#endif
+
+/*****************************************************************************
+ **
+ ** Scalar kernels
+ **
+ *****************************************************************************/
+
+static int _find_ptr_scalar(void* const* data, int n, void* val) {
+  for (int i = 0; i < n; i++) {
+    if (data[i] == val) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int _count_ptr_scalar(void* const* data, int n, void* val) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    count += data[i] == val;
+  }
+  return count;
+}
+
+static int _find_int_scalar(int const* data, int n, int key) {
+  for (int i = 0; i < n; i++) {
+    if (data[i] == key) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int _count_int_scalar(int const* data, int n, int key) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    count += data[i] == key;
+  }
+  return count;
+}
+
+#ifdef DYNARRAY_SCAN_X86
+
+/*****************************************************************************
+ **
+ ** SSE2 kernels (always available on x86-64)
+ **
+ *****************************************************************************/
+
+/*
+ * SSE2 has no 64-bit compare, so pointers are compared as pairs of 32-bit
+ * halves: a lane matches only if both of its halves do.  The result has one
+ * bit per pointer.
+ */
+static inline int _match_ptr_sse2(void* const* data, __m128i key) {
+  __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const*)data), key);
+  eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+static int _find_ptr_sse2(void* const* data, int n, void* val) {
+  __m128i key = _mm_set1_epi64x((int64_t)(intptr_t)val);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    int mask = _match_ptr_sse2(data + i, key);
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  int rest = _find_ptr_scalar(data + i, n - i, val);
+  return rest < 0 ? -1 : i + rest;
+}
+
+static int _count_ptr_sse2(void* const* data, int n, void* val) {
+  __m128i key = _mm_set1_epi64x((int64_t)(intptr_t)val);
+  int count = 0, i = 0;
+  for (; i + 2 <= n; i += 2) {
+    count += __builtin_popcount(_match_ptr_sse2(data + i, key));
+  }
+  return count + _count_ptr_scalar(data + i, n - i, val);
+}
+
+static int _find_int_sse2(int const* data, int n, int key) {
+  __m128i k = _mm_set1_epi32(key);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i eq = _mm_cmpeq_epi32(
+      _mm_loadu_si128((__m128i const*)(data + i)), k);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  int rest = _find_int_scalar(data + i, n - i, key);
+  return rest < 0 ? -1 : i + rest;
+}
+
+static int _count_int_sse2(int const* data, int n, int key) {
+  __m128i k = _mm_set1_epi32(key);
+  int count = 0, i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i eq = _mm_cmpeq_epi32(
+      _mm_loadu_si128((__m128i const*)(data + i)), k);
+    count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+  }
+  return count + _count_int_scalar(data + i, n - i, key);
+}
+
+/*****************************************************************************
+ **
+ ** AVX2 kernels (used only if the CPU supports them)
+ **
+ *****************************************************************************/
+
+__attribute__((target("avx2")))
+static int _find_ptr_avx2(void* const* data, int n, void* val) {
+  __m256i key = _mm256_set1_epi64x((int64_t)(intptr_t)val);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i eq = _mm256_cmpeq_epi64(
+      _mm256_loadu_si256((__m256i const*)(data + i)), key);
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  int rest = _find_ptr_scalar(data + i, n - i, val);
+  return rest < 0 ? -1 : i + rest;
+}
+
+__attribute__((target("avx2")))
+static int _count_ptr_avx2(void* const* data, int n, void* val) {
+  __m256i key = _mm256_set1_epi64x((int64_t)(intptr_t)val);
+  int count = 0, i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i eq = _mm256_cmpeq_epi64(
+      _mm256_loadu_si256((__m256i const*)(data + i)), key);
+    count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+  }
+  return count + _count_ptr_scalar(data + i, n - i, val);
+}
+
+__attribute__((target("avx2")))
+static int _find_int_avx2(int const* data, int n, int key) {
+  __m256i k = _mm256_set1_epi32(key);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i eq = _mm256_cmpeq_epi32(
+      _mm256_loadu_si256((__m256i const*)(data + i)), k);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  int rest = _find_int_scalar(data + i, n - i, key);
+  return rest < 0 ? -1 : i + rest;
+}
+
+__attribute__((target("avx2")))
+static int _count_int_avx2(int const* data, int n, int key) {
+  __m256i k = _mm256_set1_epi32(key);
+  int count = 0, i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i eq = _mm256_cmpeq_epi32(
+      _mm256_loadu_si256((__m256i const*)(data + i)), k);
+    count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+  }
+  return count + _count_int_scalar(data + i, n - i, key);
+}
+
+#endif
+
+/*****************************************************************************
+ **
+ ** Dispatch
+ **
+ *****************************************************************************/
+
+/*
+ * The versions of the kernels chosen for this CPU.  These start out as the
+ * scalar kernels, and on x86 machines _dynarray_scan_init() replaces them
+ * before main() runs, so they never change while other threads might be
+ * calling the kernels.
+ */
+static int (*_find_ptr)(void* const*, int, void*) = _find_ptr_scalar;
+static int (*_count_ptr)(void* const*, int, void*) = _count_ptr_scalar;
+static int (*_find_int)(int const*, int, int) = _find_int_scalar;
+static int (*_count_int)(int const*, int, int) = _count_int_scalar;
+
+#ifdef DYNARRAY_SCAN_X86
+__attribute__((constructor))
+static void _dynarray_scan_init() {
+  /*
+   * This may run before the constructor that fills in the CPU features, so
+   * fill them in here first.
+   */
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    _find_ptr = _find_ptr_avx2;
+    _count_ptr = _count_ptr_avx2;
+    _find_int = _find_int_avx2;
+    _count_int = _count_int_avx2;
+  } else {
+    _find_ptr = _find_ptr_sse2;
+    _count_ptr = _count_ptr_sse2;
+    _find_int = _find_int_sse2;
+    _count_int = _count_int_sse2;
+  }
+}
+#endif
+
+/*
+ * This function returns the index of the first element of `data` that is
+ * equal to `val` (compared as pointers), or -1 if there is no such element.
+ *
+ * Params:
+ *   data - the array to search.  May be NULL only if `n` is 0.
+ *   n - the number of elements in `data`.
+ *   val - the value to search for.
+ */
+int dynarray_scan_find_ptr(void* const* data, int n, void* val) {
+  assert(n >= 0);
+  return _find_ptr(data, n, val);
+}
+
+/*
+ * This function returns the number of elements of `data` that are equal to
+ * `val` (compared as pointers).
+ *
+ * Params:
+ *   data - the array to search.  May be NULL only if `n` is 0.
+ *   n - the number of elements in `data`.
+ *   val - the value to count.
+ */
+int dynarray_scan_count_ptr(void* const* data, int n, void* val) {
+  assert(n >= 0);
+  return _count_ptr(data, n, val);
+}
+
+/*
+ * This function returns the index of the first element of `data` that is
+ * equal to `key`, or -1 if there is no such element.  Typed dynamic arrays
+ * of ints use it through DYNARRAY_DECLARE_INT_SEARCH() in dynarray_typed.h.
+ *
+ * Params:
+ *   data - the array to search.  May be NULL only if `n` is 0.
+ *   n - the number of elements in `data`.
+ *   key - the value to search for.
+ */
+int dynarray_scan_find_int(int const* data, int n, int key) {
+  assert(n >= 0);
+  return _find_int(data, n, key);
+}
+
+/*
+ * This function returns the number of elements of `data` that are equal to
+ * `key`.
+ *
+ * Params:
+ *   data - the array to search.  May be NULL only if `n` is 0.
+ *   n - the number of elements in `data`.
+ *   key - the value to count.
+ */
+int dynarray_scan_count_int(int const* data, int n, int key) {
+  assert(n >= 0);
+  return _count_int(data, n, key);
+}
@@ -0,0 +1,21 @@
+/*
+ * This file contains the definition of the interface for the search kernels
+ * used by the dynamic arrays.  Each kernel scans a plain array of `n`
+ * elements for a key, using SSE2 or AVX2 instructions when the CPU running
+ * the program supports them and a plain loop otherwise.  You can find
+ * descriptions of the kernels in dynarray_scan.c.
+ */
+
+#ifndef __DYNARRAY_SCAN_H
+#define __DYNARRAY_SCAN_H
+
+/*
+ * Search kernel function prototypes.  Refer to dynarray_scan.c for
+ * documentation about each of these functions.
+ */
+int dynarray_scan_find_ptr(void* const* data, int n, void* val);
+int dynarray_scan_count_ptr(void* const* data, int n, void* val);
+int dynarray_scan_find_int(int const* data, int n, int key);
+int dynarray_scan_count_int(int const* data, int n, int key);
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * This file contains an implementation of a segmented dynamic array.  It has
+ * the same interface as the dynamic array in dynarray.c, but instead of
+ * keeping its elements in one buffer that is reallocated (and copied) every
+ * time it fills up, it keeps them in a series of separately allocated chunks.
+ * Growing the array only ever allocates a new chunk, so existing elements
+ * are never moved and pointers to them (see dynarray_seg_at()) stay valid
+ * until the elements are removed.
+ *
+ * Chunk 0 holds DYNARRAY_SEG_BASE elements and every chunk after that holds
+ * as many elements as all of the chunks before it combined, so chunk k holds
+ * DYNARRAY_SEG_BASE * 2^(k-1) elements.  This keeps the number of chunks
+ * logarithmic in the size of the array and lets an index be mapped to its
+ * chunk in constant time.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "dynarray_seg.h"
+
+/*
+ * The number of elements in the first chunk.  Must be a power of 2.
+ */
+#define DYNARRAY_SEG_BASE_SHIFT 3
+#define DYNARRAY_SEG_BASE (1 << DYNARRAY_SEG_BASE_SHIFT)
+
+/*
+ * The maximum number of chunks.  This is enough chunks to hold any number of
+ * elements that fits in an int.
+ */
+#define DYNARRAY_SEG_MAX_CHUNKS (32 - DYNARRAY_SEG_BASE_SHIFT)
+
+/*
+ * This structure is used to represent a single segmented dynamic array.  The
+ * `chunks` array is the directory of chunks; only the first `n_chunks` of
+ * them are allocated.
+ */
+struct dynarray_seg {
+  void** chunks[DYNARRAY_SEG_MAX_CHUNKS];
+  int n_chunks;
+  int size;
+  int capacity;
+};
+
+/*
+ * Auxilliary function to find which chunk holds the element at index `idx`
+ * and where in that chunk it is.  The chunk number is returned and the
+ * offset into the chunk is stored in `offset`.
+ */
+static int _dynarray_seg_locate(int idx, int* offset) {
+  unsigned int q = (unsigned int)idx >> DYNARRAY_SEG_BASE_SHIFT;
+  if (q == 0) {
+    *offset = idx;
+    return 0;
+  }
+
+  /*
+   * Chunk k (k >= 1) starts at index DYNARRAY_SEG_BASE * 2^(k-1), so k is one
+   * more than the position of the highest set bit of idx / DYNARRAY_SEG_BASE.
+   */
+  int k = 32 - __builtin_clz(q);
+  *offset = idx - (DYNARRAY_SEG_BASE << (k - 1));
+  return k;
+}
+
+/*
+ * Auxilliary function that returns the address of the element at index
+ * `idx` without any checks.
+ */
+static void** _dynarray_seg_slot(struct dynarray_seg* da, int idx) {
+  int offset;
+  int k = _dynarray_seg_locate(idx, &offset);
+  return &da->chunks[k][offset];
+}
+
+/*
+ * This function allocates and initializes a new, empty segmented dynamic
+ * array and returns a pointer to it.  No chunks are allocated until the
+ * first element is inserted.
+ */
+struct dynarray_seg* dynarray_seg_create() {
+  struct dynarray_seg* da = malloc(sizeof(struct dynarray_seg));
+  assert(da);
+
+  da->n_chunks = 0;
+  da->size = 0;
+  da->capacity = 0;
+
+  return da;
+}
+
+/*
+ * This function frees the memory associated with a segmented dynamic array.
+ * Freeing any memory associated with values stored in the array is the
+ * responsibility of the caller.
+ *
+ * Params:
+ *   da - the segmented dynamic array to be destroyed.  May not be NULL.
+ */
+void dynarray_seg_free(struct dynarray_seg* da) {
+  assert(da);
+
+  for (int k = 0; k < da->n_chunks; k++) {
+    free(da->chunks[k]);
+  }
+  free(da);
+}
+
+/*
+ * This function returns the size of a given segmented dynamic array (i.e.
+ * the number of elements stored in it, not the capacity).
+ */
+int dynarray_seg_size(struct dynarray_seg* da) {
+  assert(da);
+  return da->size;
+}
+
+/*
+ * This function inserts a new value at the *end* of a given segmented
+ * dynamic array.  If the array is full, a new chunk is allocated for it;
+ * none of the existing elements are moved.
+ *
+ * Params:
+ *   da - the segmented dynamic array into which to insert an element.  May
+ *     not be NULL.
+ *   val - the value to be inserted.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void dynarray_seg_insert(struct dynarray_seg* da, void* val) {
+  assert(da);
+
+  if (da->size == da->capacity) {
+    assert(da->n_chunks < DYNARRAY_SEG_MAX_CHUNKS);
+
+    /*
+     * The new chunk is as large as all of the existing ones combined, except
+     * for the first chunk.
+     */
+    int chunk_size = da->capacity > 0 ? da->capacity : DYNARRAY_SEG_BASE;
+    da->chunks[da->n_chunks] = malloc(chunk_size * sizeof(void*));
+    assert(da->chunks[da->n_chunks]);
+    da->n_chunks++;
+    da->capacity += chunk_size;
+  }
+
+  *_dynarray_seg_slot(da, da->size) = val;
+  da->size++;
+}
+
+/*
+ * This function removes an element at a specified index from a segmented
+ * dynamic array.  All existing elements following the specified index are
+ * moved forward to fill in the gap left by the removed element.  Chunks are
+ * not freed when the array shrinks, so they can be reused by later inserts.
+ *
+ * Params:
+ *   da - the segmented dynamic array from which to remove an element.  May
+ *     not be NULL.
+ *   idx - the index of the element to be removed.  The value of `idx` must be
+ *     between 0 (inclusive) and n (exclusive), where n is the number of
+ *     elements stored in the array.
+ */
+void dynarray_seg_remove(struct dynarray_seg* da, int idx) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  /*
+   * Walk the remaining elements chunk by chunk rather than mapping every
+   * index separately.
+   */
+  int offset;
+  int k = _dynarray_seg_locate(idx, &offset);
+  void** slot = &da->chunks[k][offset];
+  int chunk_end = k == 0 ? DYNARRAY_SEG_BASE : DYNARRAY_SEG_BASE << (k - 1);
+  for (int i = idx; i < da->size - 1; i++) {
+    offset++;
+    if (offset == chunk_end) {
+      k++;
+      offset = 0;
+      chunk_end = DYNARRAY_SEG_BASE << (k - 1);
+    }
+    void** next = &da->chunks[k][offset];
+    *slot = *next;
+    slot = next;
+  }
+
+  da->size--;
+}
+
+/*
+ * This function returns the value of an existing element in a segmented
+ * dynamic array.
+ *
+ * Params:
+ *   da - the segmented dynamic array from which to get a value.  May not be
+ *     NULL.
+ *   idx - the index of the element whose value should be returned.  The value
+ *     of `idx` must be between 0 (inclusive) and n (exclusive), where n is the
+ *     number of elements stored in the array.
+ */
+void* dynarray_seg_get(struct dynarray_seg* da, int idx) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  return *_dynarray_seg_slot(da, idx);
+}
+
+/*
+ * This function updates (i.e. overwrites) the value of an existing element
+ * in a segmented dynamic array.
+ *
+ * Params:
+ *   da - the segmented dynamic array in which to set a value.  May not be
+ *     NULL.
+ *   idx - the index of the element whose value should be updated.  The value
+ *     of `idx` must be between 0 (inclusive) and n (exclusive), where n is the
+ *     number of elements stored in the array.
+ *   val - the new value to be set.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void dynarray_seg_set(struct dynarray_seg* da, int idx, void* val) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  *_dynarray_seg_slot(da, idx) = val;
+}
+
+/*
+ * This function returns the address of an existing element in a segmented
+ * dynamic array.  Because chunks are never moved, this address stays valid
+ * while more elements are inserted; it only refers to a different element
+ * once an element before it is removed.
+ *
+ * Params:
+ *   da - the segmented dynamic array from which to get an address.  May not
+ *     be NULL.
+ *   idx - the index of the element whose address should be returned.  The
+ *     value of `idx` must be between 0 (inclusive) and n (exclusive), where n
+ *     is the number of elements stored in the array.
+ */
+void** dynarray_seg_at(struct dynarray_seg* da, int idx) {
+  assert(da);
+  assert(idx < da->size && idx >= 0);
+
+  return _dynarray_seg_slot(da, idx);
+}
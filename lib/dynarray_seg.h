@@ -0,0 +1,28 @@
+/*
+ * This file contains the definition of the interface for a segmented dynamic
+ * array.  You can find descriptions of the segmented dynamic array functions,
+ * including their parameters and their return values, in dynarray_seg.c.
+ */
+
+#ifndef __DYNARRAY_SEG_H
+#define __DYNARRAY_SEG_H
+
+/*
+ * Structure used to represent a segmented dynamic array.
+ */
+struct dynarray_seg;
+
+/*
+ * Segmented dynamic array interface function prototypes.  Refer to
+ * dynarray_seg.c for documentation about each of these functions.
+ */
+struct dynarray_seg* dynarray_seg_create();
+void dynarray_seg_free(struct dynarray_seg* da);
+int dynarray_seg_size(struct dynarray_seg* da);
+void dynarray_seg_insert(struct dynarray_seg* da, void* val);
+void dynarray_seg_remove(struct dynarray_seg* da, int idx);
+void* dynarray_seg_get(struct dynarray_seg* da, int idx);
+void dynarray_seg_set(struct dynarray_seg* da, int idx, void* val);
+void** dynarray_seg_at(struct dynarray_seg* da, int idx);
+
+#endif
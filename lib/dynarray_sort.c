@@ -0,0 +1,401 @@
+/*
+ * This file contains the sorting engines used by the dynamic arrays:
+ *
+ *   - an introsort (quicksort that falls back to heapsort if it starts to go
+ *     quadratic, and to insertion sort for short ranges) for arrays of void*
+ *     sorted with a comparison function;
+ *   - a merge sort that sorts the halves of large arrays on separate threads
+ *     (each with the introsort) and then merges them;
+ *   - an LSD radix sort for arrays whose elements are ordered by an int key,
+ *     which never calls a comparison function at all.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "dynarray_sort.h"
+
+/*
+ * Ranges no longer than this are sorted with insertion sort.
+ */
+#define DYNARRAY_SORT_INSERTION_MAX 16
+
+/*
+ * Arrays with at least this many elements are sorted on multiple threads.
+ * Below this, starting threads costs more than it saves.
+ */
+#define DYNARRAY_SORT_PARALLEL_MIN (1 << 16)
+
+/*
+ * The most threads a single sort will use.
+ */
+#define DYNARRAY_SORT_MAX_THREADS 8
+
+typedef int (*_dynarray_cmp)(void* a, void* b);
+
+/*****************************************************************************
+ **
+ ** Introsort
+ **
+ *****************************************************************************/
+
+static void _insertion_sort(void** data, int n, _dynarray_cmp cmp) {
+  for (int i = 1; i < n; i++) {
+    void* val = data[i];
+    int j = i;
+    while (j > 0 && cmp(val, data[j-1]) < 0) {
+      data[j] = data[j-1];
+      j--;
+    }
+    data[j] = val;
+  }
+}
+
+/*
+ * Auxilliary function to restore the max-heap property below index `i` of a
+ * heap of `n` elements.
+ */
+static void _sift_down(void** data, int i, int n, _dynarray_cmp cmp) {
+  void* val = data[i];
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= n) {
+      break;
+    }
+    if (child + 1 < n && cmp(data[child], data[child+1]) < 0) {
+      child++;
+    }
+    if (cmp(val, data[child]) >= 0) {
+      break;
+    }
+    data[i] = data[child];
+    i = child;
+  }
+  data[i] = val;
+}
+
+static void _heap_sort(void** data, int n, _dynarray_cmp cmp) {
+  for (int i = n / 2 - 1; i >= 0; i--) {
+    _sift_down(data, i, n, cmp);
+  }
+  for (int end = n - 1; end > 0; end--) {
+    void* max = data[0];
+    data[0] = data[end];
+    data[end] = max;
+    _sift_down(data, 0, end, cmp);
+  }
+}
+
+static inline void _swap(void** data, int i, int j) {
+  void* tmp = data[i];
+  data[i] = data[j];
+  data[j] = tmp;
+}
+
+/*
+ * Auxilliary function to introsort `n` elements, switching to heapsort once
+ * `depth` levels of partitioning have been used up.
+ */
+static void _introsort(void** data, int n, int depth, _dynarray_cmp cmp) {
+  while (n > DYNARRAY_SORT_INSERTION_MAX) {
+    if (depth-- == 0) {
+      _heap_sort(data, n, cmp);
+      return;
+    }
+
+    /*
+     * Order the first, middle and last elements and use the middle one as
+     * the pivot.  The first and last elements then stop the partitioning
+     * loops below from running off either end of the range.
+     */
+    int mid = n / 2;
+    if (cmp(data[mid], data[0]) < 0) {
+      _swap(data, mid, 0);
+    }
+    if (cmp(data[n-1], data[mid]) < 0) {
+      _swap(data, n - 1, mid);
+      if (cmp(data[mid], data[0]) < 0) {
+        _swap(data, mid, 0);
+      }
+    }
+    void* pivot = data[mid];
+
+    int i = 0, j = n - 1;
+    for (;;) {
+      while (cmp(data[++i], pivot) < 0);
+      while (cmp(data[--j], pivot) > 0);
+      if (i >= j) {
+        break;
+      }
+      _swap(data, i, j);
+    }
+
+    /*
+     * Recurse into the smaller side and loop on the larger one, so the stack
+     * never gets deeper than log(n).
+     */
+    if (i < n - i) {
+      _introsort(data, i, depth, cmp);
+      data += i;
+      n -= i;
+    } else {
+      _introsort(data + i, n - i, depth, cmp);
+      n = i;
+    }
+  }
+  _insertion_sort(data, n, cmp);
+}
+
+static void _introsort_all(void** data, int n, _dynarray_cmp cmp) {
+  int depth = 0;
+  for (int m = n; m > 1; m >>= 1) {
+    depth += 2;
+  }
+  _introsort(data, n, depth, cmp);
+}
+
+/*****************************************************************************
+ **
+ ** Parallel merge sort
+ **
+ *****************************************************************************/
+
+/*
+ * One part of an array to be sorted on its own thread.  `tmp` is scratch
+ * space as long as the part.
+ */
+struct _sort_task {
+  void** data;
+  void** tmp;
+  int n;
+  int threads;
+  _dynarray_cmp cmp;
+};
+
+static void _merge_sort(struct _sort_task* task);
+
+static void* _merge_sort_thread(void* arg) {
+  _merge_sort(arg);
+  return NULL;
+}
+
+/*
+ * Auxilliary function to merge the sorted ranges data[0..mid) and
+ * data[mid..n).  The left range is copied out to `tmp` first, so the merge
+ * can write straight back into `data`.  Ties are taken from the left range,
+ * so the merge is stable.
+ */
+static void _merge(void** data, void** tmp, int mid, int n,
+    _dynarray_cmp cmp) {
+  /*
+   * If the ranges are already in order, there's nothing to do.
+   */
+  if (cmp(data[mid-1], data[mid]) <= 0) {
+    return;
+  }
+
+  memcpy(tmp, data, mid * sizeof(void*));
+  int i = 0, j = mid, k = 0;
+  while (i < mid && j < n) {
+    if (cmp(data[j], tmp[i]) < 0) {
+      data[k++] = data[j++];
+    } else {
+      data[k++] = tmp[i++];
+    }
+  }
+  memcpy(data + k, tmp + i, (mid - i) * sizeof(void*));
+}
+
+static void _merge_sort(struct _sort_task* task) {
+  if (task->threads <= 1 || task->n < DYNARRAY_SORT_PARALLEL_MIN) {
+    _introsort_all(task->data, task->n, task->cmp);
+    return;
+  }
+
+  /*
+   * Sort the left half on a new thread and the right half on this one, each
+   * with its own half of the scratch space.  If a thread can't be started,
+   * just sort both halves here.
+   */
+  int mid = task->n / 2;
+  struct _sort_task left = {
+    task->data, task->tmp, mid, task->threads / 2, task->cmp
+  };
+  struct _sort_task right = {
+    task->data + mid, task->tmp + mid, task->n - mid,
+    task->threads - task->threads / 2, task->cmp
+  };
+
+  pthread_t thread;
+  int spawned = pthread_create(&thread, NULL, _merge_sort_thread, &left) == 0;
+  if (!spawned) {
+    _merge_sort(&left);
+  }
+  _merge_sort(&right);
+  if (spawned) {
+    pthread_join(thread, NULL);
+  }
+
+  _merge(task->data, task->tmp, mid, task->n, task->cmp);
+}
+
+/*
+ * Auxilliary function to choose how many threads to sort with.
+ */
+static int _sort_threads() {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus < 1) {
+    return 1;
+  }
+  return cpus < DYNARRAY_SORT_MAX_THREADS ? cpus : DYNARRAY_SORT_MAX_THREADS;
+}
+
+/*
+ * This function sorts an array of void* values into ascending order, as
+ * defined by a comparison function.  Short arrays are sorted with an
+ * introsort; arrays of at least DYNARRAY_SORT_PARALLEL_MIN elements are split
+ * up and sorted on multiple threads, then merged.  The sort is not stable.
+ *
+ * Params:
+ *   data - the array to sort.  May be NULL only if `n` is 0.
+ *   n - the number of elements in `data`.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them.  It should return a negative value if the first should
+ *     come before the second, a positive value if it should come after, and
+ *     0 if they are equivalent.  May not be NULL.
+ */
+void dynarray_sort_ptrs(void** data, int n, int (*cmp)(void* a, void* b)) {
+  assert(n >= 0);
+  assert(cmp);
+
+  if (n < DYNARRAY_SORT_PARALLEL_MIN) {
+    _introsort_all(data, n, cmp);
+    return;
+  }
+
+  void** tmp = malloc(n * sizeof(void*));
+  if (!tmp) {
+    _introsort_all(data, n, cmp);
+    return;
+  }
+  struct _sort_task task = { data, tmp, n, _sort_threads(), cmp };
+  _merge_sort(&task);
+  free(tmp);
+}
+
+/*****************************************************************************
+ **
+ ** Radix sort
+ **
+ *****************************************************************************/
+
+/*
+ * Auxilliary function to read the key of element `i`, flipped so that
+ * negative keys sort before positive ones when compared as unsigned.
+ */
+static inline unsigned int _radix_key(char const* data, int i, int elem_size,
+    int key_offset) {
+  int key;
+  memcpy(&key, data + (size_t)i * elem_size + key_offset, sizeof(int));
+  return (unsigned int)key ^ 0x80000000u;
+}
+
+/*
+ * This function sorts an array of elements into ascending order of an int
+ * key stored in each element, using a least-significant-digit radix sort.
+ * The elements can be plain ints (`elem_size` is sizeof(int) and
+ * `key_offset` is 0) or structs with an int field, which makes this suitable
+ * for typed dynamic arrays, e.g.:
+ *
+ *   dynarray_sort_radix(da->data, dynarray_point_size(da),
+ *       sizeof(struct point), offsetof(struct point, x));
+ *
+ * The sort is stable, so elements with equal keys keep their order.  It
+ * takes time proportional to `n` and needs scratch space as large as the
+ * array.
+ *
+ * Params:
+ *   data - the array to sort.  May be NULL only if `n` is 0.
+ *   n - the number of elements in `data`.
+ *   elem_size - the size of each element, in bytes.
+ *   key_offset - the offset of the int key within each element, in bytes.
+ */
+void dynarray_sort_radix(void* data, int n, int elem_size, int key_offset) {
+  assert(n >= 0);
+  assert(elem_size > 0);
+  assert(key_offset >= 0 && key_offset + (int)sizeof(int) <= elem_size);
+  if (n < 2) {
+    return;
+  }
+
+  /*
+   * Count the keys' bytes for all four passes at once.
+   */
+  int counts[4][256];
+  memset(counts, 0, sizeof(counts));
+  for (int i = 0; i < n; i++) {
+    unsigned int key = _radix_key(data, i, elem_size, key_offset);
+    for (int b = 0; b < 4; b++) {
+      counts[b][(key >> (8 * b)) & 0xff]++;
+    }
+  }
+
+  char* src = data;
+  char* dst = malloc((size_t)n * elem_size);
+  assert(dst);
+  char* scratch = dst;
+
+  for (int b = 0; b < 4; b++) {
+    unsigned int shift = 8 * b;
+
+    /*
+     * If every key has the same byte here, this pass wouldn't move anything.
+     */
+    unsigned int first = (_radix_key(src, 0, elem_size, key_offset) >> shift)
+        & 0xff;
+    if (counts[b][first] == n) {
+      continue;
+    }
+
+    int offsets[256];
+    int total = 0;
+    for (int d = 0; d < 256; d++) {
+      offsets[d] = total;
+      total += counts[b][d];
+    }
+
+    if (elem_size == sizeof(int)) {
+      int const* in = (int const*)src;
+      int* out = (int*)dst;
+      for (int i = 0; i < n; i++) {
+        unsigned int key = (unsigned int)in[i] ^ 0x80000000u;
+        out[offsets[(key >> shift) & 0xff]++] = in[i];
+      }
+    } else {
+      for (int i = 0; i < n; i++) {
+        unsigned int key = _radix_key(src, i, elem_size, key_offset);
+        int d = offsets[(key >> shift) & 0xff]++;
+        memcpy(dst + (size_t)d * elem_size, src + (size_t)i * elem_size,
+            elem_size);
+      }
+    }
+
+    char* swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  /*
+   * After an odd number of passes, the sorted elements are in the scratch
+   * space rather than the array.
+   */
+  if (src != data) {
+    memcpy(data, src, (size_t)n * elem_size);
+  }
+  free(scratch);
+}
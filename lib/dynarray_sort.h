@@ -0,0 +1,18 @@
+/*
+ * This file contains the definition of the interface for the sorting engines
+ * used by the dynamic arrays.  Each engine sorts a plain array of `n`
+ * elements in place.  You can find descriptions of the engines in
+ * dynarray_sort.c.
+ */
+
+#ifndef __DYNARRAY_SORT_H
+#define __DYNARRAY_SORT_H
+
+/*
+ * Sorting engine function prototypes.  Refer to dynarray_sort.c for
+ * documentation about each of these functions.
+ */
+void dynarray_sort_ptrs(void** data, int n, int (*cmp)(void* a, void* b));
+void dynarray_sort_radix(void* data, int n, int elem_size, int key_offset);
+
+#endif
@@ -0,0 +1,382 @@
+/*
+ * This file contains a macro-generated, typed variant of the dynamic array
+ * in dynarray.c.  Where `struct dynarray` stores every element as a void*
+ * (so each element usually lives in its own heap allocation), a typed
+ * dynamic array stores its elements by value in one contiguous buffer.
+ *
+ * To use it, declare a typed dynamic array once per element type, giving it
+ * a name that can be pasted into identifiers, e.g.:
+ *
+ *   DYNARRAY_DECLARE(int, int)
+ *   DYNARRAY_DECLARE(pq_element, struct pq_element)
+ *
+ * The first line generates `struct dynarray_int` along with the functions
+ * dynarray_int_create(), dynarray_int_free(), dynarray_int_size(),
+ * dynarray_int_insert(), dynarray_int_remove(), dynarray_int_get(),
+ * dynarray_int_set() and dynarray_int_at(), as well as the bulk operations
+ * dynarray_int_append_n(), dynarray_int_insert_range(),
+ * dynarray_int_reserve() and dynarray_int_shrink_to_fit(), the searches
+ * dynarray_int_find(), dynarray_int_count(), dynarray_int_remove_if() and
+ * dynarray_int_remove_all(), and dynarray_int_sort().  These behave just like their counterparts in
+ * dynarray.c, except that values are passed and returned by value.  All of
+ * the functions are static inline, so the declaration can be placed in any
+ * file that needs it.
+ *
+ * A typed dynamic array of ints can also get searches that use the
+ * vectorized kernels in dynarray_scan.c instead of a comparison function:
+ *
+ *   DYNARRAY_DECLARE(int, int)
+ *   DYNARRAY_DECLARE_INT_SEARCH(int)
+ *
+ * The second line generates dynarray_int_find_int() and
+ * dynarray_int_count_int(), which compare the elements directly with `key`.
+ */
+
+#ifndef __DYNARRAY_TYPED_H
+#define __DYNARRAY_TYPED_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "dynarray_scan.h"
+
+#define DYNARRAY_TYPED_INIT_CAPACITY 8
+
+#define DYNARRAY_DECLARE(name, type)                                          \
+                                                                              \
+/*                                                                            \
+ * Unlike `struct dynarray`, the fields of a typed dynamic array are visible  \
+ * so the accessors below can be inlined into their callers.                  \
+ */                                                                           \
+struct dynarray_##name {                                                      \
+  type* data;                                                                 \
+  int size;                                                                   \
+  int capacity;                                                               \
+};                                                                            \
+                                                                              \
+static inline struct dynarray_##name* dynarray_##name##_create() {            \
+  struct dynarray_##name* da = malloc(sizeof(struct dynarray_##name));        \
+  assert(da);                                                                 \
+                                                                              \
+  da->data = malloc(DYNARRAY_TYPED_INIT_CAPACITY * sizeof(type));             \
+  assert(da->data);                                                           \
+  da->size = 0;                                                               \
+  da->capacity = DYNARRAY_TYPED_INIT_CAPACITY;                                \
+                                                                              \
+  return da;                                                                  \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_free(struct dynarray_##name* da) {       \
+  assert(da);                                                                 \
+  free(da->data);                                                             \
+  free(da);                                                                   \
+}                                                                             \
+                                                                              \
+static inline int dynarray_##name##_size(struct dynarray_##name* da) {        \
+  assert(da);                                                                 \
+  return da->size;                                                            \
+}                                                                             \
+                                                                              \
+static inline void _dynarray_##name##_resize(struct dynarray_##name* da,      \
+    int new_capacity) {                                                       \
+  assert(new_capacity >= da->size && new_capacity > 0);                       \
+                                                                              \
+  type* new_data = realloc(da->data, new_capacity * sizeof(type));            \
+  assert(new_data);                                                           \
+  da->data = new_data;                                                        \
+  da->capacity = new_capacity;                                                \
+}                                                                             \
+                                                                              \
+static inline void _dynarray_##name##_grow(struct dynarray_##name* da,        \
+    int min_capacity) {                                                       \
+  int new_capacity = da->capacity;                                            \
+  while (new_capacity < min_capacity) {                                       \
+    new_capacity *= 2;                                                        \
+  }                                                                           \
+  if (new_capacity != da->capacity) {                                         \
+    _dynarray_##name##_resize(da, new_capacity);                              \
+  }                                                                           \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_reserve(struct dynarray_##name* da,      \
+    int capacity) {                                                           \
+  assert(da);                                                                 \
+  if (capacity > da->capacity) {                                              \
+    _dynarray_##name##_resize(da, capacity);                                  \
+  }                                                                           \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_shrink_to_fit(                           \
+    struct dynarray_##name* da) {                                             \
+  assert(da);                                                                 \
+  int new_capacity = da->size > 0 ? da->size : 1;                             \
+  if (new_capacity != da->capacity) {                                         \
+    _dynarray_##name##_resize(da, new_capacity);                              \
+  }                                                                           \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_append_n(struct dynarray_##name* da,     \
+    type const* vals, int n) {                                                \
+  assert(da);                                                                 \
+  assert(n >= 0);                                                             \
+  if (n == 0) {                                                               \
+    return;                                                                   \
+  }                                                                           \
+                                                                              \
+  _dynarray_##name##_grow(da, da->size + n);                                  \
+  memcpy(da->data + da->size, vals, n * sizeof(type));                        \
+  da->size += n;                                                              \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_insert_range(                            \
+    struct dynarray_##name* da, int idx, type const* vals, int n) {           \
+  assert(da);                                                                 \
+  assert(idx <= da->size && idx >= 0);                                        \
+  assert(n >= 0);                                                             \
+  if (n == 0) {                                                               \
+    return;                                                                   \
+  }                                                                           \
+                                                                              \
+  _dynarray_##name##_grow(da, da->size + n);                                  \
+  memmove(da->data + idx + n, da->data + idx,                                 \
+      (da->size - idx) * sizeof(type));                                       \
+  memcpy(da->data + idx, vals, n * sizeof(type));                             \
+  da->size += n;                                                              \
+}                                                                             \
+                                                                              \
+/*                                                                            \
+ * Search and removal by value.  `cmp` returns 0 when the two elements are    \
+ * equal, as in dynarray_find().  Arrays of ints can use the vectorized       \
+ * searches generated by DYNARRAY_DECLARE_INT_SEARCH() below instead.         \
+ */                                                                           \
+static inline int dynarray_##name##_find(struct dynarray_##name* da,          \
+    type const* val, int (*cmp)(type const* a, type const* b)) {              \
+  assert(da && cmp);                                                          \
+  for (int i = 0; i < da->size; i++) {                                        \
+    if (cmp(val, &da->data[i]) == 0) {                                        \
+      return i;                                                               \
+    }                                                                         \
+  }                                                                           \
+  return -1;                                                                  \
+}                                                                             \
+                                                                              \
+static inline int dynarray_##name##_count(struct dynarray_##name* da,         \
+    type const* val, int (*cmp)(type const* a, type const* b)) {              \
+  assert(da && cmp);                                                          \
+  int count = 0;                                                              \
+  for (int i = 0; i < da->size; i++) {                                        \
+    count += cmp(val, &da->data[i]) == 0;                                     \
+  }                                                                           \
+  return count;                                                               \
+}                                                                             \
+                                                                              \
+/*                                                                            \
+ * Removes every element for which `pred`, passed the element and `ctx`,      \
+ * returns a non-zero value, keeping the order of the rest, as in             \
+ * dynarray_remove_if().                                                      \
+ */                                                                           \
+static inline int dynarray_##name##_remove_if(struct dynarray_##name* da,     \
+    int (*pred)(type const* val, void* ctx), void* ctx) {                     \
+  assert(da && pred);                                                         \
+  int kept = 0;                                                               \
+  while (kept < da->size && !pred(&da->data[kept], ctx)) {                    \
+    kept++;                                                                   \
+  }                                                                           \
+                                                                              \
+  for (int i = kept + 1; i < da->size; i++) {                                 \
+    da->data[kept] = da->data[i];                                             \
+    kept += !pred(&da->data[kept], ctx);                                      \
+  }                                                                           \
+                                                                              \
+  int removed = da->size - kept;                                              \
+  da->size = kept;                                                            \
+  return removed;                                                             \
+}                                                                             \
+                                                                              \
+static inline int dynarray_##name##_remove_all(struct dynarray_##name* da,    \
+    type const* val, int (*cmp)(type const* a, type const* b)) {              \
+  int kept = dynarray_##name##_find(da, val, cmp);                            \
+  if (kept < 0) {                                                             \
+    return 0;                                                                 \
+  }                                                                           \
+                                                                              \
+  for (int i = kept + 1; i < da->size; i++) {                                 \
+    da->data[kept] = da->data[i];                                             \
+    kept += cmp(val, &da->data[i]) != 0;                                      \
+  }                                                                           \
+                                                                              \
+  int removed = da->size - kept;                                              \
+  da->size = kept;                                                            \
+  return removed;                                                             \
+}                                                                             \
+                                                                              \
+/*                                                                            \
+ * Sorts the array into ascending order of `cmp`, which returns a negative    \
+ * value, 0 or a positive value like the comparison functions for qsort().    \
+ * This is an introsort like the one in dynarray_sort.c, but because it is    \
+ * generated for each element type and `cmp` is usually a constant, the       \
+ * compiler can inline the comparisons and swap whole elements directly.      \
+ * Arrays ordered by an int key can use dynarray_sort_radix() instead.        \
+ */                                                                           \
+static inline void _dynarray_##name##_sift_down(type* data, int i, int n,     \
+    int (*cmp)(type const* a, type const* b)) {                               \
+  type val = data[i];                                                         \
+  for (;;) {                                                                  \
+    int child = 2 * i + 1;                                                    \
+    if (child >= n) {                                                         \
+      break;                                                                  \
+    }                                                                         \
+    if (child + 1 < n && cmp(&data[child], &data[child+1]) < 0) {             \
+      child++;                                                                \
+    }                                                                         \
+    if (cmp(&val, &data[child]) >= 0) {                                       \
+      break;                                                                  \
+    }                                                                         \
+    data[i] = data[child];                                                    \
+    i = child;                                                                \
+  }                                                                           \
+  data[i] = val;                                                              \
+}                                                                             \
+                                                                              \
+static inline void _dynarray_##name##_introsort(type* data, int n,            \
+    int depth, int (*cmp)(type const* a, type const* b)) {                    \
+  type tmp;                                                                   \
+  while (n > 16) {                                                            \
+    if (depth-- == 0) {                                                       \
+      for (int i = n / 2 - 1; i >= 0; i--) {                                  \
+        _dynarray_##name##_sift_down(data, i, n, cmp);                        \
+      }                                                                       \
+      for (int end = n - 1; end > 0; end--) {                                 \
+        tmp = data[0]; data[0] = data[end]; data[end] = tmp;                  \
+        _dynarray_##name##_sift_down(data, 0, end, cmp);                      \
+      }                                                                       \
+      return;                                                                 \
+    }                                                                         \
+                                                                              \
+    int mid = n / 2;                                                          \
+    if (cmp(&data[mid], &data[0]) < 0) {                                      \
+      tmp = data[mid]; data[mid] = data[0]; data[0] = tmp;                    \
+    }                                                                         \
+    if (cmp(&data[n-1], &data[mid]) < 0) {                                    \
+      tmp = data[n-1]; data[n-1] = data[mid]; data[mid] = tmp;                \
+      if (cmp(&data[mid], &data[0]) < 0) {                                    \
+        tmp = data[mid]; data[mid] = data[0]; data[0] = tmp;                  \
+      }                                                                       \
+    }                                                                         \
+    type pivot = data[mid];                                                   \
+                                                                              \
+    int i = 0, j = n - 1;                                                     \
+    for (;;) {                                                                \
+      while (cmp(&data[++i], &pivot) < 0);                                    \
+      while (cmp(&data[--j], &pivot) > 0);                                    \
+      if (i >= j) {                                                           \
+        break;                                                                \
+      }                                                                       \
+      tmp = data[i]; data[i] = data[j]; data[j] = tmp;                        \
+    }                                                                         \
+                                                                              \
+    if (i < n - i) {                                                          \
+      _dynarray_##name##_introsort(data, i, depth, cmp);                      \
+      data += i;                                                              \
+      n -= i;                                                                 \
+    } else {                                                                  \
+      _dynarray_##name##_introsort(data + i, n - i, depth, cmp);              \
+      n = i;                                                                  \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  for (int i = 1; i < n; i++) {                                               \
+    type val = data[i];                                                       \
+    int j = i;                                                                \
+    while (j > 0 && cmp(&val, &data[j-1]) < 0) {                              \
+      data[j] = data[j-1];                                                    \
+      j--;                                                                    \
+    }                                                                         \
+    data[j] = val;                                                            \
+  }                                                                           \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_sort(struct dynarray_##name* da,         \
+    int (*cmp)(type const* a, type const* b)) {                               \
+  assert(da && cmp);                                                          \
+  int depth = 0;                                                              \
+  for (int m = da->size; m > 1; m >>= 1) {                                    \
+    depth += 2;                                                               \
+  }                                                                           \
+  _dynarray_##name##_introsort(da->data, da->size, depth, cmp);               \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_insert(struct dynarray_##name* da,       \
+    type val) {                                                               \
+  assert(da);                                                                 \
+                                                                              \
+  if (da->size == da->capacity) {                                             \
+    _dynarray_##name##_resize(da, 2 * da->capacity);                          \
+  }                                                                           \
+                                                                              \
+  da->data[da->size] = val;                                                   \
+  da->size++;                                                                 \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_remove(struct dynarray_##name* da,       \
+    int idx) {                                                                \
+  assert(da);                                                                 \
+  assert(idx < da->size && idx >= 0);                                         \
+                                                                              \
+  for (int i = idx; i < da->size - 1; i++) {                                  \
+    da->data[i] = da->data[i+1];                                              \
+  }                                                                           \
+                                                                              \
+  da->size--;                                                                 \
+}                                                                             \
+                                                                              \
+static inline type dynarray_##name##_get(struct dynarray_##name* da,          \
+    int idx) {                                                                \
+  assert(da);                                                                 \
+  assert(idx < da->size && idx >= 0);                                         \
+                                                                              \
+  return da->data[idx];                                                       \
+}                                                                             \
+                                                                              \
+static inline void dynarray_##name##_set(struct dynarray_##name* da,          \
+    int idx, type val) {                                                      \
+  assert(da);                                                                 \
+  assert(idx < da->size && idx >= 0);                                         \
+                                                                              \
+  da->data[idx] = val;                                                        \
+}                                                                             \
+                                                                              \
+/*                                                                            \
+ * Returns a pointer to the element at `idx`, for reading or updating a       \
+ * single field in place.  The pointer is invalidated by the next insert.     \
+ */                                                                           \
+static inline type* dynarray_##name##_at(struct dynarray_##name* da,          \
+    int idx) {                                                                \
+  assert(da);                                                                 \
+  assert(idx < da->size && idx >= 0);                                         \
+                                                                              \
+  return &da->data[idx];                                                      \
+}
+
+/*
+ * Generates searches for a typed dynamic array of ints that was declared
+ * with DYNARRAY_DECLARE(name, int).  These return the same results as
+ * dynarray_##name##_find() and dynarray_##name##_count() would with a `cmp`
+ * that tests ints for equality, but compare several elements at a time.
+ */
+#define DYNARRAY_DECLARE_INT_SEARCH(name)                                     \
+                                                                              \
+static inline int dynarray_##name##_find_int(struct dynarray_##name* da,      \
+    int key) {                                                                \
+  assert(da);                                                                 \
+  return dynarray_scan_find_int(da->data, da->size, key);                     \
+}                                                                             \
+                                                                              \
+static inline int dynarray_##name##_count_int(struct dynarray_##name* da,     \
+    int key) {                                                                \
+  assert(da);                                                                 \
+  return dynarray_scan_count_int(da->data, da->size, key);                    \
+}
+
+#endif
@@ -0,0 +1,322 @@
+/*
+ * This file contains an implementation of a flat map: an ordered map from
+ * int keys to void* values, stored as two parallel typed dynamic arrays, one
+ * holding the keys in ascending order and one holding the matching values.
+ *
+ * Compared to a binary search tree, a flat map is slow to update (inserting
+ * or removing a key moves every entry after it) but much faster to search,
+ * since a lookup is a binary search over one contiguous array of ints rather
+ * than a walk through separately allocated nodes.  It suits maps that are
+ * built once, e.g. with flatmap_build(), and then mostly read.
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "flatmap.h"
+#include "dynarray_typed.h"
+#include "dynarray_sort.h"
+
+DYNARRAY_DECLARE(int, int)
+DYNARRAY_DECLARE(value, void*)
+
+/*
+ * This structure is used to represent a single flat map.  `keys` is sorted
+ * in ascending order with no duplicates, and `values->data[i]` is the value
+ * for `keys->data[i]`.
+ */
+struct flatmap {
+  struct dynarray_int* keys;
+  struct dynarray_value* values;
+};
+
+/*
+ * Key/value pair used to sort the input to flatmap_build().
+ */
+struct _flatmap_pair {
+  int key;
+  void* value;
+};
+
+/*
+ * Auxilliary function that returns the index of the first of the `n` sorted
+ * `keys` that is not less than `key`, or `n` if there is none.
+ *
+ * Each step of the search halves the range without branching on the
+ * comparison (the compiler turns the conditional add into a cmov), so the
+ * loop runs the same number of times for every key and never mispredicts.
+ * The two elements the next step might look at are prefetched, so large
+ * arrays aren't slowed down by waiting on each load in turn.
+ */
+static int _flatmap_lower_bound(int const* keys, int n, int key) {
+  if (n == 0) {
+    return 0;
+  }
+
+  int const* base = keys;
+  while (n > 1) {
+    int half = n / 2;
+    __builtin_prefetch(base + half / 2);
+    __builtin_prefetch(base + half + half / 2);
+    base += base[half] < key ? half : 0;
+    n -= half;
+  }
+  return (base - keys) + (*base < key);
+}
+
+/*
+ * This function allocates and initializes a new, empty flat map and returns
+ * a pointer to it.
+ */
+struct flatmap* flatmap_create() {
+  struct flatmap* fm = malloc(sizeof(struct flatmap));
+  assert(fm);
+
+  fm->keys = dynarray_int_create();
+  fm->values = dynarray_value_create();
+
+  return fm;
+}
+
+/*
+ * This function frees the memory associated with a flat map.  Freeing any
+ * memory associated with values stored in the map is the responsibility of
+ * the caller.
+ *
+ * Params:
+ *   fm - the flat map to be destroyed.  May not be NULL.
+ */
+void flatmap_free(struct flatmap* fm) {
+  assert(fm);
+
+  dynarray_int_free(fm->keys);
+  dynarray_value_free(fm->values);
+  free(fm);
+}
+
+/*
+ * This function returns the number of keys stored in a flat map.
+ *
+ * Params:
+ *   fm - the flat map whose size is to be returned.  May not be NULL.
+ */
+int flatmap_size(struct flatmap* fm) {
+  assert(fm);
+  return fm->keys->size;
+}
+
+/*
+ * This function inserts a key/value pair into a flat map.  If the key is
+ * already in the map, its value is replaced.  Otherwise, every entry with a
+ * greater key is moved up to make room, so building a map by inserting keys
+ * one at a time takes quadratic time; use flatmap_build() instead.
+ *
+ * Params:
+ *   fm - the flat map into which to insert the pair.  May not be NULL.
+ *   key - the key to insert.
+ *   value - the value to associate with `key`.
+ */
+void flatmap_insert(struct flatmap* fm, int key, void* value) {
+  assert(fm);
+
+  int idx = _flatmap_lower_bound(fm->keys->data, fm->keys->size, key);
+  if (idx < fm->keys->size && fm->keys->data[idx] == key) {
+    fm->values->data[idx] = value;
+    return;
+  }
+
+  dynarray_int_insert_range(fm->keys, idx, &key, 1);
+  dynarray_value_insert_range(fm->values, idx, &value, 1);
+}
+
+/*
+ * This function removes a key and its value from a flat map.  If the key is
+ * not in the map, the map is left unchanged.
+ *
+ * Params:
+ *   fm - the flat map from which to remove the key.  May not be NULL.
+ *   key - the key to remove.
+ */
+void flatmap_remove(struct flatmap* fm, int key) {
+  assert(fm);
+
+  int idx = _flatmap_lower_bound(fm->keys->data, fm->keys->size, key);
+  if (idx < fm->keys->size && fm->keys->data[idx] == key) {
+    dynarray_int_remove(fm->keys, idx);
+    dynarray_value_remove(fm->values, idx);
+  }
+}
+
+/*
+ * This function returns the value associated with a key in a flat map.
+ *
+ * Params:
+ *   fm - the flat map to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   This function returns the value associated with `key`, or NULL if `key`
+ *   is not in the map.
+ */
+void* flatmap_get(struct flatmap* fm, int key) {
+  assert(fm);
+
+  int idx = _flatmap_lower_bound(fm->keys->data, fm->keys->size, key);
+  if (idx < fm->keys->size && fm->keys->data[idx] == key) {
+    return fm->values->data[idx];
+  }
+  return NULL;
+}
+
+/*
+ * This function replaces the contents of a flat map with `n` key/value
+ * pairs, which may be in any order.  The pairs are sorted with a radix sort,
+ * so this takes time proportional to `n`.  If a key appears more than once,
+ * the last of its values is kept, just as if the pairs had been inserted one
+ * at a time.
+ *
+ * Params:
+ *   fm - the flat map to fill.  May not be NULL.
+ *   keys - the keys to store.  May be NULL only if `n` is 0.
+ *   values - the values to store, where `values[i]` is the value for
+ *     `keys[i]`.  May be NULL only if `n` is 0.
+ *   n - the number of pairs.
+ */
+void flatmap_build(struct flatmap* fm, int const* keys, void* const* values,
+    int n) {
+  assert(fm);
+  assert(n >= 0);
+
+  fm->keys->size = 0;
+  fm->values->size = 0;
+  if (n == 0) {
+    return;
+  }
+
+  struct _flatmap_pair* pairs = malloc(n * sizeof(struct _flatmap_pair));
+  assert(pairs);
+  for (int i = 0; i < n; i++) {
+    pairs[i].key = keys[i];
+    pairs[i].value = values[i];
+  }
+
+  /*
+   * The radix sort is stable, so the last value for each key is the last
+   * one in its run of equal keys.
+   */
+  dynarray_sort_radix(pairs, n, sizeof(struct _flatmap_pair),
+      offsetof(struct _flatmap_pair, key));
+
+  dynarray_int_reserve(fm->keys, n);
+  dynarray_value_reserve(fm->values, n);
+  for (int i = 0; i < n; i++) {
+    if (i + 1 < n && pairs[i+1].key == pairs[i].key) {
+      continue;
+    }
+    dynarray_int_insert(fm->keys, pairs[i].key);
+    dynarray_value_insert(fm->values, pairs[i].value);
+  }
+
+  free(pairs);
+}
+
+/*
+ * This function returns the index of the first key in a flat map that is not
+ * less than a given key, i.e. the position at which `key` is or would be
+ * stored.
+ *
+ * Params:
+ *   fm - the flat map to search.  May not be NULL.
+ *   key - the key to search for.
+ *
+ * Return:
+ *   This function returns an index between 0 and n (inclusive), where n is
+ *   the number of keys in the map.
+ */
+int flatmap_lower_bound(struct flatmap* fm, int key) {
+  assert(fm);
+  return _flatmap_lower_bound(fm->keys->data, fm->keys->size, key);
+}
+
+/*
+ * This function returns the index of the first key in a flat map that is
+ * greater than a given key.
+ *
+ * Params:
+ *   fm - the flat map to search.  May not be NULL.
+ *   key - the key to search for.
+ *
+ * Return:
+ *   This function returns an index between 0 and n (inclusive), where n is
+ *   the number of keys in the map.
+ */
+int flatmap_upper_bound(struct flatmap* fm, int key) {
+  assert(fm);
+
+  if (key == INT_MAX) {
+    return fm->keys->size;
+  }
+  return _flatmap_lower_bound(fm->keys->data, fm->keys->size, key + 1);
+}
+
+/*
+ * This function finds the entries of a flat map whose keys are between
+ * `lower` and `upper` (both inclusive).  Those entries are stored next to
+ * each other, so they can be scanned with flatmap_key_at() and
+ * flatmap_value_at(), e.g.:
+ *
+ *   int first, n = flatmap_range(fm, lower, upper, &first);
+ *   for (int i = first; i < first + n; i++) {
+ *     ... flatmap_value_at(fm, i) ...
+ *   }
+ *
+ * Params:
+ *   fm - the flat map to search.  May not be NULL.
+ *   lower - the lowest key in the range.
+ *   upper - the highest key in the range.
+ *   first - pointer to where the index of the first entry in the range
+ *     should be stored.  May not be NULL.
+ *
+ * Return:
+ *   This function returns the number of entries in the range.
+ */
+int flatmap_range(struct flatmap* fm, int lower, int upper, int* first) {
+  assert(fm);
+  assert(first);
+
+  *first = flatmap_lower_bound(fm, lower);
+  if (upper < lower) {
+    return 0;
+  }
+  return flatmap_upper_bound(fm, upper) - *first;
+}
+
+/*
+ * This function returns the key stored at a given index of a flat map.
+ *
+ * Params:
+ *   fm - the flat map from which to get the key.  May not be NULL.
+ *   idx - the index of the entry.  The value of `idx` must be between 0
+ *     (inclusive) and n (exclusive), where n is the number of keys in the
+ *     map.
+ */
+int flatmap_key_at(struct flatmap* fm, int idx) {
+  assert(fm);
+  return dynarray_int_get(fm->keys, idx);
+}
+
+/*
+ * This function returns the value stored at a given index of a flat map.
+ *
+ * Params:
+ *   fm - the flat map from which to get the value.  May not be NULL.
+ *   idx - the index of the entry.  The value of `idx` must be between 0
+ *     (inclusive) and n (exclusive), where n is the number of keys in the
+ *     map.
+ */
+void* flatmap_value_at(struct flatmap* fm, int idx) {
+  assert(fm);
+  return dynarray_value_get(fm->values, idx);
+}
@@ -0,0 +1,36 @@
+/*
+ * This file contains the definition of the interface for a flat map, an
+ * ordered map from int keys to void* values that is kept as a sorted array.
+ * You can find descriptions of the flat map functions, including their
+ * parameters and their return values, in flatmap.c.
+ */
+
+#ifndef __FLATMAP_H
+#define __FLATMAP_H
+
+/*
+ * Structure used to represent a flat map.
+ */
+struct flatmap;
+
+/*
+ * Flat map interface function prototypes.  Refer to flatmap.c for
+ * documentation about each of these functions.  The first six match the
+ * binary search tree interface in bst.h.
+ */
+struct flatmap* flatmap_create();
+void flatmap_free(struct flatmap* fm);
+int flatmap_size(struct flatmap* fm);
+void flatmap_insert(struct flatmap* fm, int key, void* value);
+void flatmap_remove(struct flatmap* fm, int key);
+void* flatmap_get(struct flatmap* fm, int key);
+
+void flatmap_build(struct flatmap* fm, int const* keys, void* const* values,
+    int n);
+int flatmap_lower_bound(struct flatmap* fm, int key);
+int flatmap_upper_bound(struct flatmap* fm, int key);
+int flatmap_range(struct flatmap* fm, int lower, int upper, int* first);
+int flatmap_key_at(struct flatmap* fm, int idx);
+void* flatmap_value_at(struct flatmap* fm, int idx);
+
+#endif
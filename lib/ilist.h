@@ -0,0 +1,210 @@
+/*
+ * This file contains an intrusive doubly-linked list.  Where `struct list`
+ * allocates a node for each element and stores the element as a void*, an
+ * intrusive list links the elements themselves: each element embeds a
+ * `struct ilist_link` field, and the list is made of those fields.  Inserting
+ * and removing elements never allocates, and walking the list reaches each
+ * element's other fields without first loading a separate node.
+ *
+ * For example, to keep `struct call` values in an intrusive list:
+ *
+ *   struct call {
+ *     int id;
+ *     struct ilist_link link;
+ *   };
+ *
+ *   struct ilist calls;
+ *   ilist_init(&calls);
+ *   ilist_insert_end(&calls, &call->link);
+ *   ...
+ *   struct call* first = ILIST_ENTRY(ilist_head(&calls), struct call, link);
+ *
+ * An element can be in only one list at a time through a given link field.
+ * The list does not own its elements: removing an element only unlinks it,
+ * and freeing the element is the responsibility of the caller.  All of the
+ * functions are static inline, so this file has no matching .c file.
+ */
+
+#ifndef __ILIST_H
+#define __ILIST_H
+
+#include <stddef.h>
+#include <assert.h>
+
+/*
+ * Structure used to link an element into an intrusive list.  Embed one of
+ * these in any struct that is to be stored in an intrusive list.
+ */
+struct ilist_link {
+  struct ilist_link* next;
+  struct ilist_link* prev;
+};
+
+/*
+ * Structure used to represent an intrusive list.  The list is circular, with
+ * `sentinel` standing in for the (nonexistent) element before the head and
+ * after the tail, so no operation has to check for the ends of the list.
+ * A list may be embedded in another struct or declared on the stack, but it
+ * must be initialized with ilist_init() before it is used, and may not be
+ * copied afterwards.
+ */
+struct ilist {
+  struct ilist_link sentinel;
+  int size;
+};
+
+/*
+ * Given a pointer to the link field `member` of a struct of type `type`,
+ * evaluates to a pointer to the struct itself.
+ */
+#define ILIST_ENTRY(link, type, member) \
+  ((type*)((char*)(link) - offsetof(type, member)))
+
+/*
+ * This function initializes an intrusive list to be empty.
+ *
+ * Params:
+ *   list - the intrusive list to initialize.  May not be NULL.
+ */
+static inline void ilist_init(struct ilist* list) {
+  assert(list);
+  list->sentinel.next = &list->sentinel;
+  list->sentinel.prev = &list->sentinel;
+  list->size = 0;
+}
+
+/*
+ * Auxilliary function to link `link` into a list between `prev` and `next`,
+ * which must be adjacent.
+ */
+static inline void _ilist_link_between(struct ilist_link* link,
+    struct ilist_link* prev, struct ilist_link* next) {
+  link->prev = prev;
+  link->next = next;
+  prev->next = link;
+  next->prev = link;
+}
+
+/*
+ * This function inserts an element at the head of an intrusive list.
+ *
+ * Params:
+ *   list - the intrusive list into which to insert an element.  May not be
+ *     NULL.
+ *   link - the link field of the element to insert.  May not be NULL, and
+ *     may not already be in a list.
+ */
+static inline void ilist_insert(struct ilist* list, struct ilist_link* link) {
+  assert(list && link);
+  _ilist_link_between(link, &list->sentinel, list->sentinel.next);
+  list->size++;
+}
+
+/*
+ * This function inserts an element at the *end* of an intrusive list.
+ *
+ * Params:
+ *   list - the intrusive list into which to insert an element.  May not be
+ *     NULL.
+ *   link - the link field of the element to insert.  May not be NULL, and
+ *     may not already be in a list.
+ */
+static inline void ilist_insert_end(struct ilist* list,
+    struct ilist_link* link) {
+  assert(list && link);
+  _ilist_link_between(link, list->sentinel.prev, &list->sentinel);
+  list->size++;
+}
+
+/*
+ * This function removes a given element from an intrusive list.  Since the
+ * element knows its neighbors, this takes constant time wherever the element
+ * is in the list.
+ *
+ * Params:
+ *   list - the intrusive list from which to remove an element.  May not be
+ *     NULL.
+ *   link - the link field of the element to remove.  May not be NULL, and
+ *     must be in `list`.
+ */
+static inline void ilist_remove(struct ilist* list, struct ilist_link* link) {
+  assert(list && link);
+  assert(list->size > 0);
+  link->prev->next = link->next;
+  link->next->prev = link->prev;
+  link->next = link->prev = NULL;
+  list->size--;
+}
+
+/*
+ * This function returns 1 if a given intrusive list is empty and 0
+ * otherwise.
+ */
+static inline int ilist_isempty(struct ilist* list) {
+  assert(list);
+  return list->size == 0;
+}
+
+/*
+ * This function returns the number of elements in a given intrusive list.
+ */
+static inline int ilist_size(struct ilist* list) {
+  assert(list);
+  return list->size;
+}
+
+/*
+ * These functions return the link field of the element at the head or the
+ * tail of an intrusive list, or NULL if the list is empty.  Use
+ * ILIST_ENTRY() to get the element itself.
+ */
+static inline struct ilist_link* ilist_head(struct ilist* list) {
+  assert(list);
+  return list->size ? list->sentinel.next : NULL;
+}
+
+static inline struct ilist_link* ilist_tail(struct ilist* list) {
+  assert(list);
+  return list->size ? list->sentinel.prev : NULL;
+}
+
+/*
+ * These functions return the link field of the element after or before a
+ * given element of an intrusive list, or NULL if the given element is the
+ * tail or the head, respectively.  Together with ilist_head() and
+ * ilist_tail(), they can be used to walk the list in either direction.
+ */
+static inline struct ilist_link* ilist_next(struct ilist* list,
+    struct ilist_link* link) {
+  assert(list && link);
+  return link->next == &list->sentinel ? NULL : link->next;
+}
+
+static inline struct ilist_link* ilist_prev(struct ilist* list,
+    struct ilist_link* link) {
+  assert(list && link);
+  return link->prev == &list->sentinel ? NULL : link->prev;
+}
+
+/*
+ * These functions remove the element at the head or the tail of an
+ * intrusive list and return its link field, or return NULL if the list is
+ * empty.
+ */
+static inline struct ilist_link* ilist_remove_head(struct ilist* list) {
+  struct ilist_link* link = ilist_head(list);
+  if (link) {
+    ilist_remove(list, link);
+  }
+  return link;
+}
+
+static inline struct ilist_link* ilist_remove_end(struct ilist* list) {
+  struct ilist_link* link = ilist_tail(list);
+  if (link) {
+    ilist_remove(list, link);
+  }
+  return link;
+}
+
+#endif
@@ -0,0 +1,418 @@
+/*
+ * This file contains an implementation of a lock-free stack: a Treiber stack,
+ * in which the top of the stack is a single word that threads update with
+ * compare-and-swap (CAS) instead of taking a lock.
+ *
+ * Two classic problems with Treiber stacks are handled as follows:
+ *
+ *   - ABA: a thread that reads the top node A, then stalls while A is popped,
+ *     other nodes are pushed and popped, and A is pushed again, would succeed
+ *     with a CAS that should fail.  To prevent this, every head word holds a
+ *     16-bit tag alongside the pointer (in the upper bits, which are unused
+ *     by user-space pointers on 64-bit machines), and every change to the
+ *     head increments the tag.
+ *
+ *   - Reclamation: a thread may still be reading a node after another thread
+ *     has popped it.  Nodes are therefore never freed while the stack exists.
+ *     Popped nodes go onto a free list (itself a tagged Treiber stack) to be
+ *     reused by later pushes, and nodes are allocated in chunks of
+ *     LFSTACK_CHUNK, all of which are freed by lfstack_free().
+ *
+ * Under heavy contention, a stack can also use an elimination array (see
+ * lfstack_create_with_elimination()).  A push and a pop whose CAS failed can
+ * meet in a slot of the array and hand the value over directly, cancelling
+ * each other out without touching the top of the stack at all.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "lfstack.h"
+
+/*
+ * The number of nodes allocated at a time.
+ */
+#define LFSTACK_CHUNK 256
+
+/*
+ * The low bits of a head word hold a pointer and the high bits hold a tag.
+ */
+#define LFSTACK_PTR_BITS 48
+#define LFSTACK_PTR_MASK ((UINT64_C(1) << LFSTACK_PTR_BITS) - 1)
+
+/*
+ * How many times a push that has offered its value in the elimination array
+ * checks for a pop to take it before withdrawing the offer.
+ */
+#define LFSTACK_ELIM_SPINS 128
+
+/*
+ * The size of a cache line.  The words that threads CAS are padded out to a
+ * cache line each, so CASes on one don't slow down CASes on another.
+ */
+#define LFSTACK_CACHE_LINE 64
+
+/*
+ * This structure is used to represent a single node of a lock-free stack.
+ * Its fields are accessed atomically, since a thread holding a stale pointer
+ * to a node may read them while the node is being reused.
+ */
+struct lfnode {
+  void* val;
+  struct lfnode* next;
+};
+
+/*
+ * This structure is used to represent a block of nodes allocated at once.
+ */
+struct lfchunk {
+  struct lfchunk* next;
+  struct lfnode nodes[LFSTACK_CHUNK];
+};
+
+/*
+ * This structure is used to represent one slot of an elimination array.  Its
+ * word holds a tagged pointer to the node a push is offering, NULL if the
+ * slot is free, or LFSTACK_TAKEN once a pop has taken the offered value.
+ */
+struct lfslot {
+  uint64_t word;
+  char pad[LFSTACK_CACHE_LINE - sizeof(uint64_t)];
+};
+
+#define LFSTACK_TAKEN ((struct lfnode*)1)
+
+/*
+ * This structure is used to represent an entire lock-free stack.  `top` and
+ * `free_nodes` are tagged pointers to the top nodes of the stack and of the
+ * free list.  `chunks` (protected by `chunk_lock`, which is only taken to
+ * allocate a new chunk) lists every chunk of nodes, and `elim` is the
+ * elimination array, with `slots` slots, or NULL if there isn't one.
+ */
+struct lfstack {
+  uint64_t top;
+  char pad1[LFSTACK_CACHE_LINE - sizeof(uint64_t)];
+  uint64_t free_nodes;
+  char pad2[LFSTACK_CACHE_LINE - sizeof(uint64_t)];
+  pthread_mutex_t chunk_lock;
+  struct lfchunk* chunks;
+  struct lfslot* elim;
+  int slots;
+};
+
+/*
+ * Auxilliary functions to pack a pointer and a tag into a head word, and to
+ * unpack them again.
+ */
+static inline uint64_t _lf_pack(struct lfnode* node, uint64_t tag) {
+  return (uint64_t)(uintptr_t)node | (tag << LFSTACK_PTR_BITS);
+}
+
+static inline struct lfnode* _lf_ptr(uint64_t word) {
+  return (struct lfnode*)(uintptr_t)(word & LFSTACK_PTR_MASK);
+}
+
+static inline uint64_t _lf_tag(uint64_t word) {
+  return word >> LFSTACK_PTR_BITS;
+}
+
+/*
+ * Auxilliary function to make one attempt at pushing `node` onto the stack
+ * (or free list) whose head word is `head`.  Returns 1 if it succeeded, or 0
+ * if another thread changed the head first.
+ */
+static int _lf_try_push(uint64_t* head, struct lfnode* node) {
+  uint64_t old = __atomic_load_n(head, __ATOMIC_RELAXED);
+  __atomic_store_n(&node->next, _lf_ptr(old), __ATOMIC_RELAXED);
+  return __atomic_compare_exchange_n(head, &old,
+    _lf_pack(node, _lf_tag(old) + 1), 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+
+/*
+ * Auxilliary function to make one attempt at popping the top node off the
+ * stack (or free list) whose head word is `head`.  Returns 1 if it succeeded,
+ * setting `node` to the popped node (NULL if the stack was empty), or 0 if
+ * another thread changed the head first.
+ */
+static int _lf_try_pop(uint64_t* head, struct lfnode** node) {
+  uint64_t old = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+  struct lfnode* top = _lf_ptr(old);
+  if (!top) {
+    *node = NULL;
+    return 1;
+  }
+
+  /*
+   * If `top` has been popped and reused since `old` was read, this reads a
+   * meaningless `next`, but the tag makes the CAS below fail.
+   */
+  struct lfnode* next = __atomic_load_n(&top->next, __ATOMIC_RELAXED);
+  if (__atomic_compare_exchange_n(head, &old, _lf_pack(next, _lf_tag(old) + 1),
+      0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    *node = top;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * Auxilliary function to return a node to a stack's free list.
+ */
+static void _lf_node_free(struct lfstack* stack, struct lfnode* node) {
+  while (!_lf_try_push(&stack->free_nodes, node))
+    ;
+}
+
+/*
+ * Auxilliary function to get a node for a stack, from its free list if
+ * possible, or else by allocating a new chunk of nodes.
+ */
+static struct lfnode* _lf_node_alloc(struct lfstack* stack) {
+  struct lfnode* node;
+  while (!_lf_try_pop(&stack->free_nodes, &node))
+    ;
+  if (node) {
+    return node;
+  }
+
+  struct lfchunk* chunk = malloc(sizeof(struct lfchunk));
+  assert(chunk);
+  assert(((uintptr_t)chunk & ~LFSTACK_PTR_MASK) == 0);
+
+  pthread_mutex_lock(&stack->chunk_lock);
+  chunk->next = stack->chunks;
+  stack->chunks = chunk;
+  pthread_mutex_unlock(&stack->chunk_lock);
+
+  for (int i = 1; i < LFSTACK_CHUNK; i++) {
+    _lf_node_free(stack, &chunk->nodes[i]);
+  }
+  return &chunk->nodes[0];
+}
+
+/*
+ * Auxilliary function to pick a slot of a stack's elimination array.  Each
+ * thread steps through the slots with its own random number generator.
+ */
+static struct lfslot* _lf_slot(struct lfstack* stack) {
+  static __thread unsigned int rand = 0;
+  if (rand == 0) {
+    rand = (unsigned int)(uintptr_t)&rand | 1;
+  }
+  rand ^= rand << 13;
+  rand ^= rand >> 17;
+  rand ^= rand << 5;
+  return &stack->elim[rand % stack->slots];
+}
+
+/*
+ * Auxilliary function for a push whose CAS failed to offer its node in the
+ * elimination array, and wait briefly for a pop to take it.  Returns 1 if a
+ * pop took the value (so the push is done and the node can be freed), or 0
+ * if not.
+ */
+static int _lf_eliminate_push(struct lfstack* stack, struct lfnode* node) {
+  struct lfslot* slot = _lf_slot(stack);
+  uint64_t old = __atomic_load_n(&slot->word, __ATOMIC_ACQUIRE);
+  if (_lf_ptr(old)) {
+    return 0;
+  }
+  uint64_t offer = _lf_pack(node, _lf_tag(old) + 1);
+  if (!__atomic_compare_exchange_n(&slot->word, &old, offer, 0,
+      __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    return 0;
+  }
+
+  for (int i = 0; i < LFSTACK_ELIM_SPINS; i++) {
+    if (__atomic_load_n(&slot->word, __ATOMIC_ACQUIRE) != offer) {
+      break;
+    }
+  }
+
+  /*
+   * Withdraw the offer.  If that fails, a pop has taken it, and the slot must
+   * be freed for the next offer.
+   */
+  uint64_t expected = offer;
+  if (__atomic_compare_exchange_n(&slot->word, &expected,
+      _lf_pack(NULL, _lf_tag(offer) + 1), 0, __ATOMIC_ACQ_REL,
+      __ATOMIC_ACQUIRE)) {
+    return 0;
+  }
+  __atomic_store_n(&slot->word, _lf_pack(NULL, _lf_tag(offer) + 2),
+    __ATOMIC_RELEASE);
+  return 1;
+}
+
+/*
+ * Auxilliary function for a pop whose CAS failed to look for a push offering
+ * a value in the elimination array.  Returns 1 and sets `val` to the value
+ * if it took one, or returns 0 if not.
+ */
+static int _lf_eliminate_pop(struct lfstack* stack, void** val) {
+  struct lfslot* slot = _lf_slot(stack);
+  uint64_t old = __atomic_load_n(&slot->word, __ATOMIC_ACQUIRE);
+  struct lfnode* node = _lf_ptr(old);
+  if (!node || node == LFSTACK_TAKEN) {
+    return 0;
+  }
+
+  /*
+   * The value is read before the CAS; if the offer changed in between, the
+   * tag makes the CAS fail.
+   */
+  void* offered = __atomic_load_n(&node->val, __ATOMIC_RELAXED);
+  if (__atomic_compare_exchange_n(&slot->word, &old,
+      _lf_pack(LFSTACK_TAKEN, _lf_tag(old) + 1), 0, __ATOMIC_ACQ_REL,
+      __ATOMIC_RELAXED)) {
+    *val = offered;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * This function allocates and initializes a new, empty lock-free stack with
+ * no elimination array and returns a pointer to it.
+ */
+struct lfstack* lfstack_create() {
+  return lfstack_create_with_elimination(0);
+}
+
+/*
+ * This function allocates and initializes a new, empty lock-free stack with
+ * an elimination array and returns a pointer to it.  The array only helps
+ * when many threads push and pop at once; about half as many slots as
+ * threads is a good size.
+ *
+ * Params:
+ *   slots - the number of slots in the elimination array, or 0 for no
+ *     elimination array.  May not be negative.
+ */
+struct lfstack* lfstack_create_with_elimination(int slots) {
+  assert(slots >= 0);
+
+  struct lfstack* stack = malloc(sizeof(struct lfstack));
+  assert(stack);
+  stack->top = _lf_pack(NULL, 0);
+  stack->free_nodes = _lf_pack(NULL, 0);
+  pthread_mutex_init(&stack->chunk_lock, NULL);
+  stack->chunks = NULL;
+  stack->slots = slots;
+  stack->elim = NULL;
+  if (slots) {
+    stack->elim = calloc(slots, sizeof(struct lfslot));
+    assert(stack->elim);
+  }
+  return stack;
+}
+
+/*
+ * This function frees the memory associated with a lock-free stack.  No other
+ * thread may be using the stack.  Freeing any memory associated with values
+ * still stored in the stack is the responsibility of the caller.
+ *
+ * Params:
+ *   stack - the lock-free stack to be destroyed.  May not be NULL.
+ */
+void lfstack_free(struct lfstack* stack) {
+  assert(stack);
+
+  struct lfchunk* next, * curr = stack->chunks;
+  while (curr) {
+    next = curr->next;
+    free(curr);
+    curr = next;
+  }
+  free(stack->elim);
+  pthread_mutex_destroy(&stack->chunk_lock);
+  free(stack);
+}
+
+/*
+ * This function returns 1 if a given lock-free stack is empty and 0
+ * otherwise.  If other threads are using the stack, the answer may be out of
+ * date by the time this function returns.
+ *
+ * Params:
+ *   stack - the lock-free stack whose emptiness is being questioned.  May not
+ *     be NULL.
+ */
+int lfstack_isempty(struct lfstack* stack) {
+  assert(stack);
+  return _lf_ptr(__atomic_load_n(&stack->top, __ATOMIC_ACQUIRE)) == NULL;
+}
+
+/*
+ * This function pushes a new value onto a given lock-free stack.  It is safe
+ * to call from any number of threads at once.
+ *
+ * Params:
+ *   stack - the lock-free stack onto which a value is to be pushed.  May not
+ *     be NULL.
+ *   val - the value to be pushed.
+ */
+void lfstack_push(struct lfstack* stack, void* val) {
+  assert(stack);
+
+  struct lfnode* node = _lf_node_alloc(stack);
+  __atomic_store_n(&node->val, val, __ATOMIC_RELAXED);
+
+  while (!_lf_try_push(&stack->top, node)) {
+    if (stack->slots && _lf_eliminate_push(stack, node)) {
+      _lf_node_free(stack, node);
+      return;
+    }
+  }
+}
+
+/*
+ * This function returns the value at the top of a given lock-free stack
+ * without removing it, or NULL if the stack is empty.  If other threads are
+ * using the stack, the value may have been popped by the time this function
+ * returns.
+ *
+ * Params:
+ *   stack - the lock-free stack from which to query the top value.  May not
+ *     be NULL.
+ */
+void* lfstack_top(struct lfstack* stack) {
+  assert(stack);
+  struct lfnode* top = _lf_ptr(__atomic_load_n(&stack->top, __ATOMIC_ACQUIRE));
+  return top ? __atomic_load_n(&top->val, __ATOMIC_RELAXED) : NULL;
+}
+
+/*
+ * This function pops a value from a given lock-free stack and returns the
+ * popped value, or NULL if the stack is empty.  It is safe to call from any
+ * number of threads at once.
+ *
+ * Params:
+ *   stack - the lock-free stack from which a value is to be popped.  May not
+ *     be NULL.
+ *
+ * Return:
+ *   This function returns the value that was popped.
+ */
+void* lfstack_pop(struct lfstack* stack) {
+  assert(stack);
+
+  struct lfnode* node;
+  void* val;
+  while (!_lf_try_pop(&stack->top, &node)) {
+    if (stack->slots && _lf_eliminate_pop(stack, &val)) {
+      return val;
+    }
+  }
+  if (!node) {
+    return NULL;
+  }
+
+  val = __atomic_load_n(&node->val, __ATOMIC_RELAXED);
+  _lf_node_free(stack, node);
+  return val;
+}
@@ -0,0 +1,29 @@
+/*
+ * This file contains the definition of the interface for a lock-free stack
+ * that can be shared between threads without a lock.  It supports the same
+ * operations as the stack in stack.h.  You can find descriptions of the
+ * lock-free stack functions, including their parameters and their return
+ * values, in lfstack.c.
+ */
+
+#ifndef __LFSTACK_H
+#define __LFSTACK_H
+
+/*
+ * Structure used to represent a lock-free stack.
+ */
+struct lfstack;
+
+/*
+ * Lock-free stack interface function prototypes.  Refer to lfstack.c for
+ * documentation about each of these functions.
+ */
+struct lfstack* lfstack_create();
+struct lfstack* lfstack_create_with_elimination(int slots);
+void lfstack_free(struct lfstack* stack);
+int lfstack_isempty(struct lfstack* stack);
+void lfstack_push(struct lfstack* stack, void* val);
+void* lfstack_top(struct lfstack* stack);
+void* lfstack_pop(struct lfstack* stack);
+
+#endif
@@ -0,0 +1,1344 @@
+/*
+ * This file contains a simple implementation of a singly-linked list.  See
+ * the documentation below for more information on the individual functions in
+ * this implementation.
+ *
+ * Each list allocates its nodes from its own pool rather than with a
+ * separate malloc() per node.  The pool hands out nodes from slabs of
+ * LIST_SLAB_MIN to LIST_SLAB_MAX nodes, and nodes that are removed from the
+ * list are kept on a free list to be reused by later inserts.  All of the
+ * slabs are freed at once when the list is freed.
+ *
+ * The list also tracks its tail and its size, so appending to it, finding
+ * its size, and splicing one list onto another all take constant time.
+ *
+ * A list whose values are kept in order can also be given a skip-list index
+ * (see list_index()), which makes searching it, inserting into it in order
+ * and removing from it take expected O(log n) time.
+ *
+ * Finally, a list can be compacted (see list_compact()): its nodes are
+ * copied, in order, into one contiguous block, so walking it reads memory
+ * sequentially instead of jumping around the heap.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "list.h"
+
+/*
+ * This structure is used to represent a single node in a singly-linked list.
+ * It is not defined in list.h, so it is not visible to the user.
+ */
+struct node {
+  void* val;
+  struct node* next;
+};
+
+/*
+ * The number of nodes in a list's first slab, and the most nodes in any
+ * slab.  Each slab is twice as big as the one before it, up to the maximum,
+ * so short lists stay small and long lists need few slabs.
+ */
+#define LIST_SLAB_MIN 8
+#define LIST_SLAB_MAX 256
+
+/*
+ * This structure is used to represent a block of nodes allocated at once.
+ */
+struct slab {
+  struct slab* next;
+  int capacity;
+  struct node nodes[];
+};
+
+/*
+ * The most express lanes a skip-list index can have.  Each lane has about a
+ * quarter of the towers of the lane below it, so this is enough for any list
+ * whose size fits in an int.
+ */
+#define LIST_SKIP_MAX_LEVELS 16
+
+/*
+ * This structure is used to represent a tower in a skip-list index: the
+ * express-lane links for one node of the list.  `links[l]` points to the next
+ * tower in lane `l` that is at least `l+1` high, and `width` counts how many
+ * nodes further along the list that tower's node is.  A link whose `next` is
+ * NULL has no tower to count to, so its width is never used; it starts at 0
+ * and stays defined through the arithmetic below.  Most nodes have no tower;
+ * the walk from the last tower to the right node follows the nodes' own
+ * `next` pointers.
+ */
+struct skip_tower {
+  struct node* node;
+  struct skip_link {
+    struct skip_tower* next;
+    int width;
+  } links[];
+};
+
+/*
+ * This structure is used to represent the skip-list index of a list.  The
+ * header tower stands before the first node of the list, at position -1, and
+ * has room for every lane, of which `levels` are in use.  `cmp` is the order
+ * the list is kept in, and `rand` is the state of the generator used to
+ * choose tower heights.
+ */
+struct skip_index {
+  int (*cmp)(void* a, void* b);
+  int levels;
+  unsigned int rand;
+  struct skip_tower* header;
+};
+
+/*
+ * This structure is used to represent an entire singly-linked list.  `tail`
+ * is the last node in the list (NULL if the list is empty), and `size` is the
+ * number of nodes in it.
+ *
+ * The list's node pool is made up of `slabs` (newest first, ending with
+ * `oldest_slab`), the first `slab_used` nodes of which have been handed out
+ * from the newest slab, and `free_nodes`, the nodes that have been removed
+ * from the list and can be reused, linked through their `next` pointers.
+ * `free_tail` is the last free node (NULL if there are none), so another
+ * list's free nodes can be joined on in constant time.
+ *
+ * While the list is being compacted, `compact_target` is the block its nodes
+ * are being copied into.  The first `compact_used` nodes of the block have
+ * been handed out, and `compact_live` of them are currently in the list.
+ * `compact_link` is the link to the next node to copy (NULL to start over
+ * from the head), and `compact_tower` is the first tower of the list's index
+ * (if it has one) at or after that node.
+ */
+struct list {
+  struct node* head;
+  struct node* tail;
+  int size;
+  struct node* free_nodes;
+  struct node* free_tail;
+  struct slab* slabs;
+  struct slab* oldest_slab;
+  int slab_used;
+  struct skip_index* index;
+  struct slab* compact_target;
+  int compact_used;
+  int compact_live;
+  struct node** compact_link;
+  struct skip_tower* compact_tower;
+};
+
+/*
+ * Auxilliary function that returns 1 if `a` and `b` are equal according to
+ * `cmp`, or are the same pointer if `cmp` is NULL, and 0 otherwise.
+ */
+static int _list_match(void* a, void* b, int (*cmp)(void* a, void* b)) {
+  return cmp ? cmp(a, b) == 0 : a == b;
+}
+
+/*
+ * Auxilliary function to make an incremental compaction of a list start its
+ * pass over again from the head.  This is called by operations that relink
+ * nodes or change the list's index, after which the point the pass has
+ * reached no longer means anything.
+ */
+static void _list_compact_restart(struct list* list) {
+  list->compact_link = NULL;
+}
+
+/*
+ * Auxilliary function that returns 1 if `node` is in the block a list is
+ * being compacted into, and 0 otherwise.
+ */
+static int _list_in_compact_target(struct list* list, struct node* node) {
+  struct slab* target = list->compact_target;
+  return target && node >= target->nodes
+    && node < target->nodes + target->capacity;
+}
+
+/*
+ * Auxilliary function to get a node for a list from its pool.  The node's
+ * fields are not initialized.
+ */
+static struct node* _list_node_alloc(struct list* list) {
+  struct node* node = list->free_nodes;
+  if (node) {
+    list->free_nodes = node->next;
+    if (!list->free_nodes) {
+      list->free_tail = NULL;
+    }
+    if (_list_in_compact_target(list, node)) {
+      list->compact_live++;
+    }
+    return node;
+  }
+
+  if (!list->slabs || list->slab_used == list->slabs->capacity) {
+    int capacity = LIST_SLAB_MIN;
+    if (list->slabs) {
+      capacity = 2 * list->slabs->capacity;
+      if (capacity > LIST_SLAB_MAX) {
+        capacity = LIST_SLAB_MAX;
+      }
+    }
+
+    struct slab* slab = malloc(sizeof(struct slab)
+      + capacity * sizeof(struct node));
+    assert(slab);
+    slab->next = list->slabs;
+    slab->capacity = capacity;
+    if (!list->slabs) {
+      list->oldest_slab = slab;
+    }
+    list->slabs = slab;
+    list->slab_used = 0;
+  }
+
+  return &list->slabs->nodes[list->slab_used++];
+}
+
+/*
+ * Auxilliary function to return a node to a list's pool so it can be reused.
+ */
+static void _list_node_free(struct list* list, struct node* node) {
+  if (list->compact_target) {
+    if (_list_in_compact_target(list, node)) {
+      list->compact_live--;
+    }
+    if (list->compact_link == &node->next) {
+      _list_compact_restart(list);
+    }
+  }
+  if (!list->free_nodes) {
+    list->free_tail = node;
+  }
+  node->next = list->free_nodes;
+  list->free_nodes = node;
+}
+
+/*
+ * Auxilliary function to free the skip-list index of a list, if it has one.
+ * The list itself is left unchanged.  This is called by every operation
+ * that could leave the list out of order or change it in a way the index
+ * doesn't track.
+ */
+static void _list_drop_index(struct list* list) {
+  struct skip_index* index = list->index;
+  if (!index) {
+    return;
+  }
+  _list_compact_restart(list);
+
+  /*
+   * Every tower is in the lowest lane, so walking it visits all of them.
+   */
+  struct skip_tower* next, * curr = index->header;
+  while (curr) {
+    next = curr->links[0].next;
+    free(curr);
+    curr = next;
+  }
+  free(index);
+  list->index = NULL;
+}
+
+/*
+ * Auxilliary function to allocate a skip-list tower for `node` with `height`
+ * lanes.  Every link starts out NULL, with a width of 0.
+ */
+static struct skip_tower* _list_skip_tower(struct node* node, int height) {
+  struct skip_tower* tower = malloc(sizeof(struct skip_tower)
+    + height * sizeof(struct skip_link));
+  assert(tower);
+  tower->node = node;
+  for (int l = 0; l < height; l++) {
+    tower->links[l].next = NULL;
+    tower->links[l].width = 0;
+  }
+  return tower;
+}
+
+/*
+ * Auxilliary function to choose the height of the tower for a new node in a
+ * skip-list index.  A node has a tower at least `h` high with probability
+ * 4^-h, so most nodes (three in four) get no tower at all.
+ */
+static int _list_skip_height(struct skip_index* index) {
+  unsigned int r = index->rand;
+  r ^= r << 13;
+  r ^= r >> 17;
+  r ^= r << 5;
+  index->rand = r;
+
+  int height = 0;
+  while (height < LIST_SKIP_MAX_LEVELS && (r & 3) == 0) {
+    height++;
+    r >>= 2;
+  }
+  return height;
+}
+
+/*
+ * Auxilliary function to search a list by its skip-list index for the first
+ * node whose value is not ordered before `val`.
+ *
+ * Params:
+ *   list - the list to search.  Must have an index.
+ *   val - the value to search for.
+ *   update - set to the last tower before the found node in each lane in
+ *     use.  Must have room for LIST_SKIP_MAX_LEVELS towers.
+ *   ranks - set to the positions of the nodes of the towers in `update`.
+ *   prev - set to the node before the found node, or NULL if there is none.
+ *   pos - set to the position of the found node.
+ *
+ * Return:
+ *   Returns the found node, or NULL if every value in the list is ordered
+ *   before `val`.
+ */
+static struct node* _list_skip_find(struct list* list, void* val,
+    struct skip_tower** update, int* ranks, struct node** prev, int* pos) {
+  struct skip_index* index = list->index;
+  struct skip_tower* tower = index->header;
+  int rank = -1;
+
+  for (int l = index->levels - 1; l >= 0; l--) {
+    while (tower->links[l].next
+        && index->cmp(tower->links[l].next->node->val, val) < 0) {
+      rank += tower->links[l].width;
+      tower = tower->links[l].next;
+    }
+    update[l] = tower;
+    ranks[l] = rank;
+  }
+
+  /*
+   * Finish with a short walk along the nodes themselves.
+   */
+  struct node* before = tower->node;
+  struct node* curr = before ? before->next : list->head;
+  rank++;
+  while (curr && index->cmp(curr->val, val) < 0) {
+    before = curr;
+    curr = curr->next;
+    rank++;
+  }
+
+  *prev = before;
+  *pos = rank;
+  return curr;
+}
+
+/*
+ * Auxilliary function to remove `node` from the skip-list index of a list,
+ * given the last tower before it in each lane (as found by
+ * _list_skip_find()).  The node itself is not unlinked from the list.
+ */
+static void _list_skip_unlink(struct list* list, struct skip_tower** update,
+    struct node* node) {
+  struct skip_index* index = list->index;
+  struct skip_tower* tower = update[0]->links[0].next;
+  if (tower && tower->node != node) {
+    tower = NULL;
+  }
+  _list_compact_restart(list);
+
+  for (int l = 0; l < index->levels; l++) {
+    struct skip_link* link = &update[l]->links[l];
+    if (tower && link->next == tower) {
+      link->width += tower->links[l].width - 1;
+      link->next = tower->links[l].next;
+    } else {
+      link->width--;
+    }
+  }
+  free(tower);
+
+  while (index->levels > 0 && !index->header->links[index->levels - 1].next) {
+    index->levels--;
+  }
+}
+
+/*
+ * This function allocates and initializes a new, empty linked list and
+ * returns a pointer to it.  No nodes are allocated until the first element
+ * is inserted.
+ */
+struct list* list_create() {
+  struct list* list = malloc(sizeof(struct list));
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  list->free_nodes = NULL;
+  list->free_tail = NULL;
+  list->slabs = NULL;
+  list->oldest_slab = NULL;
+  list->slab_used = 0;
+  list->index = NULL;
+  list->compact_target = NULL;
+  list->compact_used = 0;
+  list->compact_live = 0;
+  list->compact_link = NULL;
+  list->compact_tower = NULL;
+  return list;
+}
+
+/*
+ * This function frees the memory associated with a linked list.  Freeing any
+ * memory associated with values still stored in the list is the responsibility
+ * of the caller.
+ *
+ * Params:
+ *   list - the linked list to be destroyed.  May not be NULL.
+ */
+void list_free(struct list* list) {
+  assert(list);
+
+  _list_drop_index(list);
+
+  /*
+   * Free the slabs holding all of the nodes.  There's no need to visit the
+   * individual nodes.
+   */
+  struct slab* next, * curr = list->slabs;
+  while (curr != NULL) {
+    next = curr->next;
+    free(curr);
+    curr = next;
+  }
+  free(list->compact_target);
+
+  free(list);
+}
+
+/*
+ * This function inserts a new value into a given linked list.  The new element
+ * is always inserted as the head of the list.
+ *
+ * Params:
+ *   list - the linked list into which to insert an element.  May not be NULL.
+ *   val - the value to be inserted.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void list_insert(struct list* list, void* val) {
+  assert(list);
+  _list_drop_index(list);
+
+  /*
+   * Create new node and insert at head.
+   */
+  struct node* temp = _list_node_alloc(list);
+  temp->val = val;
+  temp->next = list->head;
+  list->head = temp;
+  if (!list->tail) {
+    list->tail = temp;
+  }
+  list->size++;
+}
+
+/*
+ * This function inserts a new value at the *end* of a given linked list.
+ *
+ * Params:
+ *   list - the linked list into which to insert an element.  May not be NULL.
+ *   val - the value to be inserted.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void list_insert_end(struct list* list, void* val) {
+  assert(list);
+  _list_drop_index(list);
+
+  struct node* temp = _list_node_alloc(list);
+  temp->val = val;
+  temp->next = NULL;
+
+  if (list->tail) {
+    list->tail->next = temp;
+  } else {
+    list->head = temp;
+  }
+  list->tail = temp;
+  list->size++;
+}
+
+/*
+ * This function removes an element with a specified value from a given
+ * linked list.  If the specified value appears multiple times in the list,
+ * only the *first* instance of that value (i.e. the one nearest to the head
+ * of the list) is removed.  This function is passed a function pointer that
+ * is used to compare the value `val` to be removed with the values stored in
+ * the list to determine which element (if any) to remove.
+ *
+ * Params:
+ *   list - the linked list from which to remove an element.  May not be NULL.
+ *   val - the value to be removed.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ *   cmp - pointer to a function that can be passed two void* values from
+ *     to compare them for equality, as described above.  If the two values
+ *     passed are to be considered equal, this function should return 0.
+ *     Otherwise, it should return a non-zero value.  If `cmp` is NULL, the
+ *     values are compared as pointers.
+ */
+void list_remove(struct list* list, void* val, int (*cmp)(void* a, void* b)) {
+  assert(list);
+
+  if (list->index && cmp == list->index->cmp) {
+    struct skip_tower* update[LIST_SKIP_MAX_LEVELS];
+    int ranks[LIST_SKIP_MAX_LEVELS], pos;
+    struct node* prev, * curr;
+    curr = _list_skip_find(list, val, update, ranks, &prev, &pos);
+    if (curr && cmp(val, curr->val) == 0) {
+      _list_skip_unlink(list, update, curr);
+      if (prev) {
+        prev->next = curr->next;
+      } else {
+        list->head = curr->next;
+      }
+      if (curr == list->tail) {
+        list->tail = prev;
+      }
+      list->size--;
+      _list_node_free(list, curr);
+    }
+    return;
+  }
+
+  struct node* prev = NULL, * curr = list->head;
+  while (curr) {
+    /*
+     * If current node's value matches query value, update node prior to curr
+     * to point around curr, then free curr and return.  This removes curr from
+     * the list.
+     */
+    if (_list_match(val, curr->val, cmp)) {
+      _list_drop_index(list);
+      if (prev) {
+        prev->next = curr->next;
+      } else {
+        list->head = curr->next;
+      }
+      if (curr == list->tail) {
+        list->tail = prev;
+      }
+      list->size--;
+      _list_node_free(list, curr);
+      return;
+    }
+
+    prev = curr;
+    curr = curr->next;
+  }
+}
+
+/*
+ * This returns the position (i.e. the 0-based "index") of the first instance
+ * of a specified value within a given linked list (i.e. the one nearest to the
+ * head of the list).  If the list does not contain the specified value, this
+ * function returns the special value -1. This function is passed a function
+ * pointer called `cmp` that is used to compare the value `val` to be located
+ * with the values stored in the list to determine which node (if any) contains
+ * `val`.
+ *
+ * Params:
+ *   list - the linked list from which to remove an element.  May not be NULL.
+ *   val - the value to be located.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ *   cmp - pointer to a function that can be passed two void* values from
+ *     to compare them for equality, as described above.  If the two values
+ *     passed are to be considered equal, this function should return 0.
+ *     Otherwise, it should return a non-zero value.  If `cmp` is NULL, the
+ *     values are compared as pointers.
+ *
+ * Return:
+ *   This function returns the 0-based position of the first instance of `val`
+ *    within `list`, as determined by the function `cmp` (i.e. the closest
+ *    such instance to the head of the list) or -1 if `list` does not contain
+ *    the value `val`.
+ */
+int list_position(struct list* list, void* val, int (*cmp)(void* a, void* b)) {
+  assert(list);
+
+  if (list->index && cmp == list->index->cmp) {
+    struct skip_tower* update[LIST_SKIP_MAX_LEVELS];
+    int ranks[LIST_SKIP_MAX_LEVELS], pos;
+    struct node* prev, * curr;
+    curr = _list_skip_find(list, val, update, ranks, &prev, &pos);
+    return curr && cmp(val, curr->val) == 0 ? pos : -1;
+  }
+
+  struct node* curr = list->head;
+  int i = 0;
+  while (curr) {
+    /*
+     * If curr's value matches the query value, return the position of curr.
+     */
+    if (_list_match(val, curr->val, cmp)) {
+      return i;
+    }
+
+    curr = curr->next;
+    i++;
+  }
+
+  /*
+   * If we got all the way through the list and no element matched `val`, then
+   * `val` didn't exist in the list, so return -1.
+   */
+  return -1;
+}
+
+/*
+ * This function should reverse the order of the nodes in a given linked list.
+ * The reversal should be done *in place*, i.e. within the existing list, and
+ * new memory should not be allocated to accomplish the reversal.  You should
+ * be able to accomplish the reversal with a single pass through the list.
+ *
+ * Params:
+ *   list - the linked list to be reversed.  May not be NULL.  When this
+ *     function returns this should contain the reversed list.
+ */
+void list_reverse(struct list* list) {
+  assert(list);
+  _list_drop_index(list);
+  _list_compact_restart(list);
+
+  /*
+   * Reverse the list by reversing the individual nodes, making each node's
+   * next pointer point to what used to be the previous node.  Move the list's
+   * head pointer through the list as we iterate from node to node, so at the
+   * end of the iteration, the head pointer will end up pointing to what used
+   * to be the tail of the list.
+   */
+  struct node* next, * curr = list->head, * prev = NULL;
+  list->tail = curr;
+  while (curr) {
+    next = curr->next;
+    curr->next = prev;
+    list->head = prev = curr;
+    curr = next;
+  }
+}
+
+/*
+ * This function removes the last element of a given linked list.  If the
+ * list is empty, it is left unchanged.  Since the list is only linked
+ * forwards, this still has to walk the list to find the new tail.
+ *
+ * Params:
+ *   list - the linked list from which to remove an element.  May not be NULL.
+ */
+void list_remove_end(struct list* list) {
+  assert(list);
+  _list_drop_index(list);
+
+  if (!list->head) {
+    return;
+  }
+
+  struct node* prev = NULL;
+  if (list->head != list->tail) {
+    prev = list->head;
+    while (prev->next != list->tail) {
+      prev = prev->next;
+    }
+  }
+
+  _list_node_free(list, list->tail);
+  if (prev) {
+    prev->next = NULL;
+  } else {
+    list->head = NULL;
+  }
+  list->tail = prev;
+  list->size--;
+}
+
+/*
+ * This function returns 1 if a given linked list is empty and 0 otherwise.
+ *
+ * Params:
+ *   list - the linked list to check.  May not be NULL.
+ */
+int list_isempty(struct list* list) {
+  assert(list);
+  if (list->head) {
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+/*
+ * This function returns the value stored at the head of a given linked list,
+ * or NULL if the list is empty.
+ *
+ * Params:
+ *   list - the linked list whose head value is to be returned.  May not be
+ *     NULL.
+ */
+void* list_head(struct list* list) {
+  assert(list);
+
+  if (list->head) {
+    return list->head->val;
+  } else {
+    return NULL;
+  }
+}
+
+/*
+ * This function removes the element at the head of a given linked list.  If
+ * the list is empty, it is left unchanged.
+ *
+ * Params:
+ *   list - the linked list from which to remove the head.  May not be NULL.
+ */
+void list_remove_head(struct list* list) {
+  assert(list);
+
+  if (list->head) {
+    struct node* old_head = list->head;
+    if (list->index) {
+      struct skip_tower* update[LIST_SKIP_MAX_LEVELS];
+      for (int l = 0; l < list->index->levels; l++) {
+        update[l] = list->index->header;
+      }
+      _list_skip_unlink(list, update, old_head);
+    }
+    list->head = old_head->next;
+    if (!list->head) {
+      list->tail = NULL;
+    }
+    list->size--;
+    _list_node_free(list, old_head);
+  }
+}
+
+/*
+ * This function returns the number of elements in a given linked list.
+ *
+ * Params:
+ *   list - the linked list whose size is to be returned.  May not be NULL.
+ */
+int list_size(struct list* list) {
+  assert(list);
+  return list->size;
+}
+
+/*
+ * This function returns the number of nodes a given linked list has
+ * allocated memory for, whether they are in the list, on its free list, or
+ * not handed out yet.  It walks the list's slabs rather than its nodes, so
+ * it is cheap, and it can be used to check that a list reuses its nodes
+ * rather than growing without bound.
+ *
+ * Params:
+ *   list - the linked list whose pool is to be measured.  May not be NULL.
+ */
+int list_pool_size(struct list* list) {
+  assert(list);
+  int count = 0;
+  for (struct slab* slab = list->slabs; slab; slab = slab->next) {
+    count += slab->capacity;
+  }
+  if (list->compact_target) {
+    count += list->compact_target->capacity;
+  }
+  return count;
+}
+
+/*
+ * The most runs list_sort() can have waiting to be merged.  Run i holds 2^i
+ * nodes, so this is enough for any list whose size fits in an int.
+ */
+#define LIST_SORT_RUNS 32
+
+/*
+ * Auxilliary function to merge two sorted, NULL-terminated chains of nodes
+ * into one, by relinking the nodes.  When values compare equal, the node
+ * from chain `a` comes first, so the merge is stable.
+ *
+ * Params:
+ *   a, a_tail - the first node and the last node of the first chain.  May
+ *     not be NULL.
+ *   b, b_tail - the first node and the last node of the second chain.  May
+ *     not be NULL.
+ *   cmp - the comparison function, as described in list_sort().
+ *   tail - set to the last node of the merged chain.
+ *
+ * Return:
+ *   Returns the first node of the merged chain.
+ */
+static struct node* _list_merge(struct node* a, struct node* a_tail,
+    struct node* b, struct node* b_tail, int (*cmp)(void* a, void* b),
+    struct node** tail) {
+  struct node* head, ** link = &head;
+  while (a && b) {
+    if (cmp(a->val, b->val) <= 0) {
+      *link = a;
+      link = &a->next;
+      a = a->next;
+    } else {
+      *link = b;
+      link = &b->next;
+      b = b->next;
+    }
+  }
+
+  /*
+   * Whichever chain is left over goes on the end as it is, so its tail is the
+   * tail of the merged chain.
+   */
+  if (a) {
+    *link = a;
+    *tail = a_tail;
+  } else {
+    *link = b;
+    *tail = b_tail;
+  }
+  return head;
+}
+
+/*
+ * This function sorts the elements of a given linked list into ascending
+ * order, as defined by a comparison function.  The sort is a stable,
+ * bottom-up merge sort that relinks the existing nodes, so it takes
+ * O(n log n) time and allocates no memory.
+ *
+ * Params:
+ *   list - the linked list to sort.  May not be NULL.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them.  It should return a negative value if the first should
+ *     come before the second, a positive value if it should come after, and
+ *     0 if they are equivalent.  May not be NULL.
+ */
+void list_sort(struct list* list, int (*cmp)(void* a, void* b)) {
+  assert(list);
+  assert(cmp);
+
+  _list_drop_index(list);
+  _list_compact_restart(list);
+
+  /*
+   * Take the nodes off the list one at a time, like adding 1 to a binary
+   * counter: `runs[i]` is either empty or a sorted run of 2^i nodes.  Each new
+   * node is merged with runs[0], the result with runs[1], and so on until an
+   * empty slot is found.  Runs in higher slots always hold earlier nodes, so
+   * they are passed to _list_merge() first, which keeps the sort stable.
+   */
+  struct node* runs[LIST_SORT_RUNS] = { NULL };
+  struct node* run_tails[LIST_SORT_RUNS];
+  struct node* run, * run_tail, * next, * curr = list->head;
+  int i;
+
+  while (curr) {
+    next = curr->next;
+    curr->next = NULL;
+    run = run_tail = curr;
+    for (i = 0; runs[i]; i++) {
+      run = _list_merge(runs[i], run_tails[i], run, run_tail, cmp, &run_tail);
+      runs[i] = NULL;
+    }
+    runs[i] = run;
+    run_tails[i] = run_tail;
+    curr = next;
+  }
+
+  /*
+   * Merge the remaining runs together, from the latest nodes to the
+   * earliest.
+   */
+  run = run_tail = NULL;
+  for (i = 0; i < LIST_SORT_RUNS; i++) {
+    if (!runs[i]) {
+      continue;
+    }
+    if (run) {
+      run = _list_merge(runs[i], run_tails[i], run, run_tail, cmp, &run_tail);
+    } else {
+      run = runs[i];
+      run_tail = run_tails[i];
+    }
+  }
+  list->head = run;
+  list->tail = run_tail;
+}
+
+/*
+ * Auxilliary function to give up on compacting a list.  The block the list's
+ * nodes were being copied into becomes an ordinary slab in the list's pool,
+ * since some of the list's nodes may already be in it.
+ */
+static void _list_compact_abandon(struct list* list) {
+  struct slab* target = list->compact_target;
+  if (!target) {
+    return;
+  }
+
+  target->next = NULL;
+  if (list->slabs) {
+    list->oldest_slab->next = target;
+  } else {
+    list->slabs = target;
+    list->slab_used = target->capacity;
+  }
+  list->oldest_slab = target;
+  list->compact_target = NULL;
+  _list_compact_restart(list);
+}
+
+/*
+ * Auxilliary function to finish compacting a list, once every node in it has
+ * been copied into the compaction block.  The list's old slabs are freed, and
+ * the compaction block becomes the only slab in its pool.  Free nodes that
+ * were in the old slabs are forgotten.
+ */
+static void _list_compact_finish(struct list* list) {
+  struct slab* target = list->compact_target;
+  struct node* first = target->nodes, * end = target->nodes + target->capacity;
+
+  struct node* node, * free_nodes = list->free_nodes;
+  list->free_nodes = list->free_tail = NULL;
+  while (free_nodes) {
+    node = free_nodes;
+    free_nodes = node->next;
+    if (node >= first && node < end) {
+      if (!list->free_nodes) {
+        list->free_tail = node;
+      }
+      node->next = list->free_nodes;
+      list->free_nodes = node;
+    }
+  }
+
+  struct slab* next, * curr = list->slabs;
+  while (curr != NULL) {
+    next = curr->next;
+    free(curr);
+    curr = next;
+  }
+
+  target->next = NULL;
+  list->slabs = list->oldest_slab = target;
+  list->slab_used = list->compact_used;
+  list->compact_target = NULL;
+  list->compact_link = NULL;
+}
+
+/*
+ * This function does part of the work of compacting a linked list, so the
+ * work can be spread out over idle time.  Compacting a list copies its nodes,
+ * in order, into a single new block of memory and frees the memory they were
+ * in before, so that walking the list (in list_position() or list_reverse(),
+ * for example) reads memory sequentially instead of taking a cache miss for
+ * every node.  The block has some room to spare, so nodes inserted soon
+ * after are allocated right after it.
+ *
+ * The list can be used normally between calls.  Each call continues a pass
+ * over the list from where the last one stopped.  If values were inserted
+ * behind that point, or the list was reversed, sorted, spliced or changed
+ * through its index, another pass is needed, which skips quickly over the
+ * nodes that have already been copied.
+ *
+ * Params:
+ *   list - the linked list to compact.  May not be NULL.
+ *   budget - the most nodes to visit in this call.  Must be positive.
+ *
+ * Return:
+ *   Returns 1 if the list is now fully compacted, or 0 if more calls are
+ *   needed.
+ */
+int list_compact_step(struct list* list, int budget) {
+  assert(list);
+  assert(budget > 0);
+
+  if (!list->compact_target) {
+    int capacity = list->size + list->size / 8 + LIST_SLAB_MIN;
+    list->compact_target = malloc(sizeof(struct slab)
+      + capacity * sizeof(struct node));
+    assert(list->compact_target);
+    list->compact_target->capacity = capacity;
+    list->compact_used = 0;
+    list->compact_live = 0;
+    list->compact_link = NULL;
+  }
+
+  struct slab* target = list->compact_target;
+  struct node* first = target->nodes, * end = target->nodes + target->capacity;
+  if (!list->compact_link) {
+    list->compact_link = &list->head;
+    list->compact_tower = list->index ? list->index->header->links[0].next
+      : NULL;
+  }
+
+  struct node** link = list->compact_link;
+  struct skip_tower* tower = list->compact_tower;
+  for (; budget > 0 && *link; budget--) {
+    struct node* node = *link;
+    if (node < first || node >= end) {
+      /*
+       * If the list has grown too much for the block since it was allocated,
+       * start over with a bigger one.
+       */
+      if (list->compact_used == target->capacity) {
+        _list_compact_abandon(list);
+        return 0;
+      }
+
+      struct node* copy = &target->nodes[list->compact_used++];
+      list->compact_live++;
+      *copy = *node;
+      *link = copy;
+      if (list->tail == node) {
+        list->tail = copy;
+      }
+      if (tower && tower->node == node) {
+        tower->node = copy;
+      }
+      node = copy;
+    }
+    if (tower && tower->node == node) {
+      tower = tower->links[0].next;
+    }
+    link = &node->next;
+  }
+  list->compact_link = link;
+  list->compact_tower = tower;
+
+  if (*link) {
+    return 0;
+  }
+
+  /*
+   * At the end of a pass, the list is compacted if every node in it is in
+   * the block.  Otherwise, some were inserted behind the pass, so start
+   * another.
+   */
+  if (list->compact_live != list->size) {
+    _list_compact_restart(list);
+    return 0;
+  }
+  _list_compact_finish(list);
+  return 1;
+}
+
+/*
+ * This function compacts a linked list all at once.  See list_compact_step()
+ * for a description of compaction.  This takes O(n) time.
+ *
+ * Params:
+ *   list - the linked list to compact.  May not be NULL.
+ */
+void list_compact(struct list* list) {
+  assert(list);
+  while (!list_compact_step(list, list->size + 1))
+    ;
+}
+
+/*
+ * Auxilliary function to move the node pool of `src` into `dst`, so that
+ * `dst` owns (and will eventually free) the slabs holding the nodes of `src`.
+ * `src` is left with an empty pool.
+ *
+ * The slabs of `src` are chained after the oldest slab of `dst`, so `dst`
+ * keeps handing out nodes from its own newest slab, and the nodes `src` had
+ * not handed out yet from its newest slab (at most LIST_SLAB_MAX of them)
+ * are put on the free list instead.  The free nodes of `src` are joined onto
+ * the end of the free list of `dst`, so none of them are lost.
+ */
+static void _list_take_pool(struct list* dst, struct list* src) {
+  _list_compact_abandon(src);
+  if (src->slabs) {
+    if (dst->slabs) {
+      struct slab* slab = src->slabs;
+      for (int i = src->slab_used; i < slab->capacity; i++) {
+        if (!src->free_nodes) {
+          src->free_tail = &slab->nodes[i];
+        }
+        slab->nodes[i].next = src->free_nodes;
+        src->free_nodes = &slab->nodes[i];
+      }
+      dst->oldest_slab->next = src->slabs;
+    } else {
+      dst->slabs = src->slabs;
+      dst->slab_used = src->slab_used;
+    }
+    dst->oldest_slab = src->oldest_slab;
+  }
+  if (src->free_nodes) {
+    if (dst->free_nodes) {
+      dst->free_tail->next = src->free_nodes;
+    } else {
+      dst->free_nodes = src->free_nodes;
+    }
+    dst->free_tail = src->free_tail;
+  }
+
+  src->free_nodes = NULL;
+  src->free_tail = NULL;
+  src->slabs = NULL;
+  src->oldest_slab = NULL;
+  src->slab_used = 0;
+}
+
+/*
+ * Auxilliary function to empty `src` of its nodes once they have been linked
+ * into `dst`.
+ */
+static void _list_take_nodes(struct list* dst, struct list* src) {
+  _list_drop_index(dst);
+  _list_drop_index(src);
+  _list_compact_restart(dst);
+  dst->size += src->size;
+  _list_take_pool(dst, src);
+  src->head = NULL;
+  src->tail = NULL;
+  src->size = 0;
+}
+
+/*
+ * This function moves all of the elements of one linked list onto the *end*
+ * of another, preserving their order, and leaves the first list empty.  The
+ * nodes themselves are moved, not copied, so this takes constant time no
+ * matter how long either list is.  `src` can still be used (or freed)
+ * afterwards.
+ *
+ * Params:
+ *   dst - the linked list onto whose end to move the elements.  May not be
+ *     NULL.
+ *   src - the linked list whose elements are to be moved.  May not be NULL,
+ *     and may not be the same list as `dst`.
+ */
+void list_concat(struct list* dst, struct list* src) {
+  assert(dst && src);
+  assert(dst != src);
+
+  if (!src->head) {
+    return;
+  }
+  if (dst->tail) {
+    dst->tail->next = src->head;
+  } else {
+    dst->head = src->head;
+  }
+  dst->tail = src->tail;
+  _list_take_nodes(dst, src);
+}
+
+/*
+ * This function moves all of the elements of one linked list onto the *head*
+ * of another, preserving their order, and leaves the first list empty.  Like
+ * list_concat(), this takes constant time.
+ *
+ * Params:
+ *   dst - the linked list onto whose head to move the elements.  May not be
+ *     NULL.
+ *   src - the linked list whose elements are to be moved.  May not be NULL,
+ *     and may not be the same list as `dst`.
+ */
+void list_splice(struct list* dst, struct list* src) {
+  assert(dst && src);
+  assert(dst != src);
+
+  if (!src->head) {
+    return;
+  }
+  src->tail->next = dst->head;
+  dst->head = src->head;
+  if (!dst->tail) {
+    dst->tail = src->tail;
+  }
+  _list_take_nodes(dst, src);
+}
+
+/*
+ * This function merges two linked lists that are each already sorted (e.g.
+ * by list_sort()) with the same comparison function.  All of the elements
+ * of `src` are moved into `dst` at their sorted positions, and `src` is left
+ * empty.  This takes time linear in the combined length of the lists and
+ * allocates no memory.  Elements of `dst` come before equal elements of
+ * `src`.
+ *
+ * Params:
+ *   dst - the sorted linked list into which to merge.  May not be NULL.
+ *   src - the sorted linked list whose elements are to be moved.  May not be
+ *     NULL, and may not be the same list as `dst`.
+ *   cmp - the comparison function the lists are sorted by, as described in
+ *     list_sort().  May not be NULL.
+ */
+void list_merge_sorted(struct list* dst, struct list* src,
+    int (*cmp)(void* a, void* b)) {
+  assert(dst && src);
+  assert(dst != src);
+  assert(cmp);
+
+  if (!src->head) {
+    return;
+  }
+  if (!dst->head) {
+    list_concat(dst, src);
+    return;
+  }
+  dst->head = _list_merge(dst->head, dst->tail, src->head, src->tail, cmp,
+    &dst->tail);
+  _list_take_nodes(dst, src);
+}
+
+/*
+ * This function gives a linked list a skip-list index, ordered by a given
+ * comparison function: express lanes of links that skip over runs of nodes,
+ * layered over the list's own nodes.  The list is first sorted with
+ * list_sort().  From then on, as long as the list has its index:
+ *
+ *   - list_insert_sorted(), list_remove() and list_position() take expected
+ *     O(log n) time when called with the same `cmp`.
+ *   - list_remove_head() keeps the index up to date.
+ *
+ * Any other operation that changes the list (including list_remove() with a
+ * different `cmp`, if it removes an element) removes the index, after which
+ * those operations go back to scanning the list.  Call this function again to
+ * rebuild it.  The index takes about half as much memory again as the nodes
+ * themselves.
+ *
+ * Params:
+ *   list - the linked list to index.  May not be NULL.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them, as described in list_sort().  May not be NULL.
+ */
+void list_index(struct list* list, int (*cmp)(void* a, void* b)) {
+  assert(list);
+  assert(cmp);
+
+  list_sort(list, cmp);
+
+  struct skip_index* index = malloc(sizeof(struct skip_index));
+  assert(index);
+  index->cmp = cmp;
+  index->levels = 0;
+  index->rand = 2463534242u;
+  index->header = _list_skip_tower(NULL, LIST_SKIP_MAX_LEVELS);
+
+  /*
+   * Build the lanes in one pass, appending each new tower to the last tower
+   * seen in each of its lanes.
+   */
+  struct skip_tower* last[LIST_SKIP_MAX_LEVELS];
+  int last_rank[LIST_SKIP_MAX_LEVELS];
+  for (int l = 0; l < LIST_SKIP_MAX_LEVELS; l++) {
+    last[l] = index->header;
+    last_rank[l] = -1;
+  }
+
+  int rank = 0;
+  for (struct node* curr = list->head; curr; curr = curr->next, rank++) {
+    int height = _list_skip_height(index);
+    if (height == 0) {
+      continue;
+    }
+    struct skip_tower* tower = _list_skip_tower(curr, height);
+    for (int l = 0; l < height; l++) {
+      last[l]->links[l].next = tower;
+      last[l]->links[l].width = rank - last_rank[l];
+      last[l] = tower;
+      last_rank[l] = rank;
+    }
+    if (height > index->levels) {
+      index->levels = height;
+    }
+  }
+
+  list->index = index;
+}
+
+/*
+ * This function inserts a new value into a linked list that is sorted by a
+ * given comparison function, before any values equal to it, so the list stays
+ * sorted.  If the list has a skip-list index ordered by `cmp` (see
+ * list_index()), this takes expected O(log n) time and keeps the index up
+ * to date.  Otherwise it walks the list, and removes any index the list has
+ * with a different order.
+ *
+ * Params:
+ *   list - the sorted linked list into which to insert an element.  May not
+ *     be NULL.
+ *   val - the value to be inserted.
+ *   cmp - pointer to a function that can be passed two void* values to
+ *     compare them, as described in list_sort().  May not be NULL.
+ */
+void list_insert_sorted(struct list* list, void* val,
+    int (*cmp)(void* a, void* b)) {
+  assert(list);
+  assert(cmp);
+
+  struct node* temp = _list_node_alloc(list);
+  temp->val = val;
+
+  if (list->index && list->index->cmp != cmp) {
+    _list_drop_index(list);
+  }
+
+  if (!list->index) {
+    struct node* prev = NULL, * curr = list->head;
+    while (curr && cmp(curr->val, val) < 0) {
+      prev = curr;
+      curr = curr->next;
+    }
+    temp->next = curr;
+    if (prev) {
+      prev->next = temp;
+    } else {
+      list->head = temp;
+    }
+    if (!curr) {
+      list->tail = temp;
+    }
+    list->size++;
+    return;
+  }
+
+  struct skip_index* index = list->index;
+  struct skip_tower* update[LIST_SKIP_MAX_LEVELS];
+  int ranks[LIST_SKIP_MAX_LEVELS], pos;
+  struct node* prev, * curr;
+  curr = _list_skip_find(list, val, update, ranks, &prev, &pos);
+
+  temp->next = curr;
+  if (prev) {
+    prev->next = temp;
+  } else {
+    list->head = temp;
+  }
+  if (!curr) {
+    list->tail = temp;
+  }
+  list->size++;
+
+  _list_compact_restart(list);
+  int height = _list_skip_height(index);
+  for (int l = index->levels; l < height; l++) {
+    index->header->links[l].next = NULL;
+    index->header->links[l].width = 0;
+    update[l] = index->header;
+    ranks[l] = -1;
+  }
+  if (height > index->levels) {
+    index->levels = height;
+  }
+
+  /*
+   * Link the new tower in after the last tower before it in each of its
+   * lanes, splitting that tower's width.  The links that pass over the new
+   * node in the lanes above it just get one wider.
+   */
+  struct skip_tower* tower = height ? _list_skip_tower(temp, height) : NULL;
+  for (int l = 0; l < index->levels; l++) {
+    struct skip_link* link = &update[l]->links[l];
+    if (l < height) {
+      tower->links[l].next = link->next;
+      tower->links[l].width = ranks[l] + link->width + 1 - pos;
+      link->next = tower;
+      link->width = pos - ranks[l];
+    } else {
+      link->width++;
+    }
+  }
+}
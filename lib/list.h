@@ -23,8 +23,25 @@ struct list;
 struct list* list_create();
 void list_free(struct list* list);
 void list_insert(struct list* list, void* val);
+void list_insert_end(struct list* list, void* val);
 void list_remove(struct list* list, void* val, int (*cmp)(void* a, void* b));
+void list_remove_end(struct list* list);
 int list_position(struct list* list, void* val, int (*cmp)(void* a, void* b));
 void list_reverse(struct list* list);
+int list_isempty(struct list* list);
+void* list_head(struct list* list);
+void list_remove_head(struct list* list);
+int list_size(struct list* list);
+int list_pool_size(struct list* list);
+void list_concat(struct list* dst, struct list* src);
+void list_splice(struct list* dst, struct list* src);
+void list_sort(struct list* list, int (*cmp)(void* a, void* b));
+void list_merge_sorted(struct list* dst, struct list* src,
+    int (*cmp)(void* a, void* b));
+void list_index(struct list* list, int (*cmp)(void* a, void* b));
+void list_insert_sorted(struct list* list, void* val,
+    int (*cmp)(void* a, void* b));
+int list_compact_step(struct list* list, int budget);
+void list_compact(struct list* list);
 
 #endif
@@ -0,0 +1,464 @@
+/*
+ * This file contains an implementation of a bounded multi-producer,
+ * multi-consumer (MPMC) queue, after Dmitry Vyukov's design.  The values are
+ * stored in a ring of slots whose size is a power of 2, and each slot has a
+ * sequence number that says whose turn it is to use the slot:
+ *
+ *   - A slot whose sequence number equals the enqueue position `pos` is free
+ *     for the producer that claims `pos` (by advancing `enqueue_pos` from
+ *     `pos` to `pos + 1` with a CAS).  That producer stores its value and
+ *     then sets the sequence number to `pos + 1`.
+ *
+ *   - A slot whose sequence number equals `pos + 1` holds the value for the
+ *     consumer that claims dequeue position `pos` the same way.  That
+ *     consumer takes the value and then sets the sequence number to
+ *     `pos + capacity`, which is the enqueue position that will next use the
+ *     slot.
+ *
+ * A producer that finds a sequence number below its position knows the queue
+ * is full, and a consumer that finds one below its position plus 1 knows it
+ * is empty.  Producers only contend with each other on `enqueue_pos`, and
+ * consumers on `dequeue_pos`; the two sides only meet in the slots.
+ *
+ * The blocking operations first retry for a short while, and then park the
+ * thread on a futex until the other side makes progress.  Each side of the
+ * queue has an "event count": a futex word whose low bit says that threads
+ * are asleep on it, and whose other bits count the times those threads have
+ * been woken.  A thread that is about to sleep sets the low bit, tries once
+ * more, and only then sleeps on the futex, which fails at once if the word
+ * has changed since the bit was set.  A thread that enqueues (or dequeues) a
+ * value checks the low bit, and if it is set, advances the count (clearing
+ * the bit) and wakes every sleeper.  So a wakeup can't be lost between the
+ * last try and the sleep, and only the first value after threads go to
+ * sleep pays for a system call: the fast path is a load of the word.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <assert.h>
+#include <sched.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "mpmcqueue.h"
+
+/*
+ * The size of a cache line, used to keep fields that different threads write
+ * apart.
+ */
+#define MPMCQUEUE_CACHE_LINE 64
+
+/*
+ * How many times a blocking operation retries before parking the thread.
+ */
+#define MPMCQUEUE_SPINS 64
+
+/*
+ * This structure is used to represent one slot of an MPMC queue.
+ */
+struct mpmcslot {
+  unsigned long seq;
+  void* val;
+};
+
+/*
+ * This structure is used to represent the event count on which threads wait
+ * for one side of a queue.  `word` is the futex word, with MPMCQUEUE_ASLEEP
+ * set while threads are asleep on it.
+ */
+struct mpmcevent {
+  unsigned int word;
+  char pad[MPMCQUEUE_CACHE_LINE - sizeof(unsigned int)];
+};
+
+#define MPMCQUEUE_ASLEEP 1u
+
+/*
+ * This structure is used to represent an entire MPMC queue.  `not_empty` is
+ * where consumers wait for a value, and `not_full` is where producers wait
+ * for a free slot.
+ */
+struct mpmcqueue {
+  struct mpmcslot* slots;
+  unsigned long mask;
+  char pad1[MPMCQUEUE_CACHE_LINE];
+  unsigned long enqueue_pos;
+  char pad2[MPMCQUEUE_CACHE_LINE - sizeof(unsigned long)];
+  unsigned long dequeue_pos;
+  char pad3[MPMCQUEUE_CACHE_LINE - sizeof(unsigned long)];
+  struct mpmcevent not_empty;
+  struct mpmcevent not_full;
+};
+
+/*
+ * This function allocates and initializes a new, empty MPMC queue and returns
+ * a pointer to it.
+ *
+ * Params:
+ *   capacity - the most values the queue can hold at once.  This is rounded
+ *     up to a power of 2, and must be at least 2.
+ */
+struct mpmcqueue* mpmcqueue_create(int capacity) {
+  assert(capacity >= 2);
+
+  unsigned long size = 2;
+  while (size < (unsigned long)capacity) {
+    size *= 2;
+  }
+
+  struct mpmcqueue* queue = calloc(1, sizeof(struct mpmcqueue));
+  assert(queue);
+  queue->slots = malloc(size * sizeof(struct mpmcslot));
+  assert(queue->slots);
+  for (unsigned long i = 0; i < size; i++) {
+    queue->slots[i].seq = i;
+  }
+  queue->mask = size - 1;
+  return queue;
+}
+
+/*
+ * This function frees the memory associated with an MPMC queue.  No other
+ * thread may be using the queue.  Freeing any memory associated with values
+ * still stored in the queue is the responsibility of the caller.
+ *
+ * Params:
+ *   queue - the MPMC queue to be destroyed.  May not be NULL.
+ */
+void mpmcqueue_free(struct mpmcqueue* queue) {
+  assert(queue);
+  free(queue->slots);
+  free(queue);
+}
+
+/*
+ * This function returns the most values a given MPMC queue can hold at once.
+ */
+int mpmcqueue_capacity(struct mpmcqueue* queue) {
+  assert(queue);
+  return (int)(queue->mask + 1);
+}
+
+/*
+ * This function returns 1 if a given MPMC queue is empty and 0 otherwise.  If
+ * other threads are using the queue, the answer may be out of date by the
+ * time this function returns.
+ *
+ * Params:
+ *   queue - the MPMC queue whose emptiness is being questioned.  May not be
+ *     NULL.
+ */
+int mpmcqueue_isempty(struct mpmcqueue* queue) {
+  assert(queue);
+  unsigned long pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_ACQUIRE);
+  struct mpmcslot* slot = &queue->slots[pos & queue->mask];
+  return __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + 1;
+}
+
+/*
+ * Auxilliary function to sleep on an event count's futex, as long as its
+ * word is still `word`, for at most `timeout` (or indefinitely if `timeout`
+ * is NULL).  It may return early for any reason.
+ */
+static void _mpmc_wait(struct mpmcevent* ev, unsigned int word,
+    struct timespec* timeout) {
+#ifdef __linux__
+  syscall(SYS_futex, &ev->word, FUTEX_WAIT_PRIVATE, word, timeout, NULL, 0);
+#else
+  (void)ev;
+  (void)word;
+  (void)timeout;
+  sched_yield();
+#endif
+}
+
+/*
+ * Auxilliary function, called after a value is enqueued (or dequeued), to
+ * wake the threads asleep on the corresponding event count, if there are
+ * any.  The fence orders the caller's update of the slot before the load of
+ * the word; it pairs with the one in _mpmc_block().
+ */
+static void _mpmc_signal(struct mpmcevent* ev) {
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  unsigned int word = __atomic_load_n(&ev->word, __ATOMIC_RELAXED);
+  if (!(word & MPMCQUEUE_ASLEEP)) {
+    return;
+  }
+
+  /*
+   * Only signalling threads change the word while the bit is set, so if the
+   * CAS fails, another one has already woken the sleepers.
+   */
+  if (__atomic_compare_exchange_n(&ev->word, &word, word + 1, 0,
+      __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+#ifdef __linux__
+    syscall(SYS_futex, &ev->word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL,
+      0);
+#endif
+  }
+}
+
+/*
+ * Auxilliary function to compute the remaining time until `deadline` into
+ * `left`.  Returns 0 if the deadline has passed, or 1 otherwise.
+ */
+static int _mpmc_time_left(struct timespec* deadline, struct timespec* left) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  left->tv_sec = deadline->tv_sec - now.tv_sec;
+  left->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+  if (left->tv_nsec < 0) {
+    left->tv_sec--;
+    left->tv_nsec += 1000000000L;
+  }
+  return left->tv_sec >= 0;
+}
+
+/*
+ * Auxilliary function to run `attempt` (mpmcqueue_try_enqueue() or
+ * mpmcqueue_try_dequeue(), adapted to the same signature) until it succeeds
+ * or `timeout_ms` milliseconds have passed, parking the thread on `ev`
+ * between attempts.  A negative timeout means wait indefinitely.  Returns 1
+ * if an attempt succeeded, or 0 if the wait timed out.
+ */
+static int _mpmc_block(struct mpmcqueue* queue, struct mpmcevent* ev,
+    int (*attempt)(struct mpmcqueue*, void**), void** val, int timeout_ms) {
+  struct timespec deadline, left, * timeout = NULL;
+  int i;
+
+  for (i = 0; i < MPMCQUEUE_SPINS; i++) {
+    if (attempt(queue, val)) {
+      return 1;
+    }
+  }
+  if (timeout_ms == 0) {
+    return 0;
+  }
+  if (timeout_ms > 0) {
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+    }
+    timeout = &left;
+  }
+
+  while (1) {
+    unsigned int word = __atomic_load_n(&ev->word, __ATOMIC_ACQUIRE);
+    if (!(word & MPMCQUEUE_ASLEEP)) {
+      if (!__atomic_compare_exchange_n(&ev->word, &word,
+          word | MPMCQUEUE_ASLEEP, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        continue;
+      }
+      word |= MPMCQUEUE_ASLEEP;
+    }
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (attempt(queue, val)) {
+      return 1;
+    }
+    if (timeout && !_mpmc_time_left(&deadline, &left)) {
+      return 0;
+    }
+    _mpmc_wait(ev, word, timeout);
+    if (attempt(queue, val)) {
+      return 1;
+    }
+  }
+}
+
+/*
+ * Auxilliary function to make one attempt at claiming an enqueue position in
+ * a queue and storing `val` there, without signalling waiting consumers.
+ */
+static int _mpmc_try_enqueue(struct mpmcqueue* queue, void* val) {
+  unsigned long pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+  struct mpmcslot* slot;
+  while (1) {
+    slot = &queue->slots[pos & queue->mask];
+    long diff = (long)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, 1,
+          __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return 0;
+    } else {
+      pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->val = val;
+  __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+/*
+ * Auxilliary function to make one attempt at claiming a dequeue position in a
+ * queue and taking the value there, without signalling waiting producers.
+ */
+static int _mpmc_try_dequeue(struct mpmcqueue* queue, void** val) {
+  unsigned long pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+  struct mpmcslot* slot;
+  while (1) {
+    slot = &queue->slots[pos & queue->mask];
+    long diff = (long)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE)
+      - (pos + 1));
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&queue->dequeue_pos, &pos, pos + 1, 1,
+          __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return 0;
+    } else {
+      pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+    }
+  }
+
+  *val = slot->val;
+  __atomic_store_n(&slot->seq, pos + queue->mask + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+/*
+ * Auxilliary function to adapt _mpmc_try_enqueue() to _mpmc_block().
+ */
+static int _mpmc_attempt_enqueue(struct mpmcqueue* queue, void** val) {
+  return _mpmc_try_enqueue(queue, *val);
+}
+
+/*
+ * This function enqueues a value into a given MPMC queue if there is room for
+ * it, without waiting.
+ *
+ * Params:
+ *   queue - the MPMC queue into which a value is to be enqueued.  May not be
+ *     NULL.
+ *   val - the value to be enqueued.
+ *
+ * Return:
+ *   This function returns 1 if the value was enqueued, or 0 if the queue was
+ *   full.
+ */
+int mpmcqueue_try_enqueue(struct mpmcqueue* queue, void* val) {
+  assert(queue);
+  if (!_mpmc_try_enqueue(queue, val)) {
+    return 0;
+  }
+  _mpmc_signal(&queue->not_empty);
+  return 1;
+}
+
+/*
+ * This function dequeues a value from a given MPMC queue if there is one,
+ * without waiting.
+ *
+ * Params:
+ *   queue - the MPMC queue from which a value is to be dequeued.  May not be
+ *     NULL.
+ *   val - where to store the dequeued value.  May not be NULL.
+ *
+ * Return:
+ *   This function returns 1 if a value was dequeued, or 0 if the queue was
+ *   empty.
+ */
+int mpmcqueue_try_dequeue(struct mpmcqueue* queue, void** val) {
+  assert(queue && val);
+  if (!_mpmc_try_dequeue(queue, val)) {
+    return 0;
+  }
+  _mpmc_signal(&queue->not_full);
+  return 1;
+}
+
+/*
+ * This function enqueues a value into a given MPMC queue, waiting at most a
+ * given time for there to be room for it.
+ *
+ * Params:
+ *   queue - the MPMC queue into which a value is to be enqueued.  May not be
+ *     NULL.
+ *   val - the value to be enqueued.
+ *   timeout_ms - the most milliseconds to wait, or a negative number to wait
+ *     as long as it takes.
+ *
+ * Return:
+ *   This function returns 1 if the value was enqueued, or 0 if the queue was
+ *   still full after `timeout_ms` milliseconds.
+ */
+int mpmcqueue_enqueue_timeout(struct mpmcqueue* queue, void* val,
+    int timeout_ms) {
+  assert(queue);
+  if (!_mpmc_block(queue, &queue->not_full, _mpmc_attempt_enqueue, &val,
+      timeout_ms)) {
+    return 0;
+  }
+  _mpmc_signal(&queue->not_empty);
+  return 1;
+}
+
+/*
+ * This function dequeues a value from a given MPMC queue, waiting at most a
+ * given time for there to be one.
+ *
+ * Params:
+ *   queue - the MPMC queue from which a value is to be dequeued.  May not be
+ *     NULL.
+ *   val - where to store the dequeued value.  May not be NULL.
+ *   timeout_ms - the most milliseconds to wait, or a negative number to wait
+ *     as long as it takes.
+ *
+ * Return:
+ *   This function returns 1 if a value was dequeued, or 0 if the queue was
+ *   still empty after `timeout_ms` milliseconds.
+ */
+int mpmcqueue_dequeue_timeout(struct mpmcqueue* queue, void** val,
+    int timeout_ms) {
+  assert(queue && val);
+  if (!_mpmc_block(queue, &queue->not_empty, _mpmc_try_dequeue, val,
+      timeout_ms)) {
+    return 0;
+  }
+  _mpmc_signal(&queue->not_full);
+  return 1;
+}
+
+/*
+ * This function enqueues a value into a given MPMC queue, waiting as long as
+ * it takes for there to be room for it.
+ *
+ * Params:
+ *   queue - the MPMC queue into which a value is to be enqueued.  May not be
+ *     NULL.
+ *   val - the value to be enqueued.
+ */
+void mpmcqueue_enqueue(struct mpmcqueue* queue, void* val) {
+  mpmcqueue_enqueue_timeout(queue, val, -1);
+}
+
+/*
+ * This function dequeues a value from a given MPMC queue and returns it,
+ * waiting as long as it takes for there to be one.
+ *
+ * Params:
+ *   queue - the MPMC queue from which a value is to be dequeued.  May not be
+ *     NULL.
+ *
+ * Return:
+ *   This function returns the value that was dequeued.
+ */
+void* mpmcqueue_dequeue(struct mpmcqueue* queue) {
+  void* val;
+  mpmcqueue_dequeue_timeout(queue, &val, -1);
+  return val;
+}
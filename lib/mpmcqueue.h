@@ -0,0 +1,37 @@
+/*
+ * This file contains the definition of the interface for a multi-producer,
+ * multi-consumer (MPMC) queue: a bounded queue that any number of threads can
+ * enqueue into and dequeue from at once.  Each operation comes in three
+ * forms: a try_ form that fails immediately if the queue is full (or empty),
+ * a blocking form that waits until it can succeed, and a _timeout form that
+ * waits at most a given time.  You can find descriptions of the MPMC queue
+ * functions, including their parameters and their return values, in
+ * mpmcqueue.c.
+ */
+
+#ifndef __MPMCQUEUE_H
+#define __MPMCQUEUE_H
+
+/*
+ * Structure used to represent an MPMC queue.
+ */
+struct mpmcqueue;
+
+/*
+ * MPMC queue interface function prototypes.  Refer to mpmcqueue.c for
+ * documentation about each of these functions.
+ */
+struct mpmcqueue* mpmcqueue_create(int capacity);
+void mpmcqueue_free(struct mpmcqueue* queue);
+int mpmcqueue_capacity(struct mpmcqueue* queue);
+int mpmcqueue_isempty(struct mpmcqueue* queue);
+int mpmcqueue_try_enqueue(struct mpmcqueue* queue, void* val);
+int mpmcqueue_try_dequeue(struct mpmcqueue* queue, void** val);
+void mpmcqueue_enqueue(struct mpmcqueue* queue, void* val);
+void* mpmcqueue_dequeue(struct mpmcqueue* queue);
+int mpmcqueue_enqueue_timeout(struct mpmcqueue* queue, void* val,
+  int timeout_ms);
+int mpmcqueue_dequeue_timeout(struct mpmcqueue* queue, void** val,
+  int timeout_ms);
+
+#endif
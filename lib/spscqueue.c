@@ -0,0 +1,290 @@
+/*
+ * This file contains an implementation of a single-producer, single-consumer
+ * (SPSC) queue.  The values are stored in a ring buffer whose capacity is a
+ * power of 2, and the queue is described by two counters that only ever
+ * increase: `head`, the number of values dequeued so far, and `tail`, the
+ * number of values enqueued so far.  The value numbered `i` is stored at
+ * index `i & mask` of the buffer.
+ *
+ * Only the producer writes `tail` and only the consumer writes `head`, so
+ * neither needs a CAS.  The producer stores a value and then publishes it
+ * by storing the new `tail` with release ordering; the consumer loads `tail`
+ * with acquire ordering before reading the values below it, and does the
+ * same with `head` in the other direction to hand the slots back.
+ *
+ * The two counters are kept on separate cache lines, so the producer and
+ * consumer don't fight over one line.  Each side also keeps a private copy
+ * of the other side's counter (`head_cache` for the producer, `tail_cache`
+ * for the consumer), and only reloads the real counter, pulling its cache
+ * line across from the other core, when the copy says the queue is full (or
+ * empty).  When the queue is neither, an enqueue or dequeue touches no cache
+ * line that the other thread is writing except for the slot itself.
+ *
+ * Exactly one thread may enqueue and exactly one thread may dequeue at any
+ * time; they may be the same thread.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "spscqueue.h"
+
+/*
+ * The size of a cache line, used to keep the producer's and consumer's fields
+ * apart.
+ */
+#define SPSCQUEUE_CACHE_LINE 64
+
+/*
+ * This structure is used to represent an entire SPSC queue.  The first group
+ * of fields never changes after the queue is created, the second group is
+ * only written by the consumer, and the third group is only written by the
+ * producer.
+ */
+struct spscqueue {
+  void** vals;
+  unsigned long mask;
+  char pad1[SPSCQUEUE_CACHE_LINE];
+
+  unsigned long head;
+  unsigned long tail_cache;
+  char pad2[SPSCQUEUE_CACHE_LINE];
+
+  unsigned long tail;
+  unsigned long head_cache;
+  char pad3[SPSCQUEUE_CACHE_LINE];
+};
+
+/*
+ * This function allocates and initializes a new, empty SPSC queue and returns
+ * a pointer to it.
+ *
+ * Params:
+ *   capacity - the most values the queue can hold at once.  This is rounded
+ *     up to a power of 2.  Must be positive.
+ */
+struct spscqueue* spscqueue_create(int capacity) {
+  assert(capacity > 0);
+
+  unsigned long size = 1;
+  while (size < (unsigned long)capacity) {
+    size *= 2;
+  }
+
+  struct spscqueue* queue = malloc(sizeof(struct spscqueue));
+  assert(queue);
+  queue->vals = malloc(size * sizeof(void*));
+  assert(queue->vals);
+  queue->mask = size - 1;
+  queue->head = queue->tail_cache = 0;
+  queue->tail = queue->head_cache = 0;
+  return queue;
+}
+
+/*
+ * This function frees the memory associated with an SPSC queue.  Neither the
+ * producer nor the consumer may be using the queue.  Freeing any memory
+ * associated with values still stored in the queue is the responsibility of
+ * the caller.
+ *
+ * Params:
+ *   queue - the SPSC queue to be destroyed.  May not be NULL.
+ */
+void spscqueue_free(struct spscqueue* queue) {
+  assert(queue);
+  free(queue->vals);
+  free(queue);
+}
+
+/*
+ * This function returns the most values a given SPSC queue can hold at once.
+ */
+int spscqueue_capacity(struct spscqueue* queue) {
+  assert(queue);
+  return (int)(queue->mask + 1);
+}
+
+/*
+ * This function returns 1 if a given SPSC queue is empty and 0 otherwise.  It
+ * may be called by either thread, but if called by the producer, the answer
+ * may be out of date by the time this function returns.
+ *
+ * Params:
+ *   queue - the SPSC queue whose emptiness is being questioned.  May not be
+ *     NULL.
+ */
+int spscqueue_isempty(struct spscqueue* queue) {
+  assert(queue);
+  return __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)
+    == __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Auxilliary function, called by the producer, to return the number of free
+ * slots in a queue, reloading the consumer's `head` only if its cached copy
+ * shows fewer than `want` free slots.
+ */
+static inline unsigned long _spscqueue_free_slots(struct spscqueue* queue,
+    unsigned long tail, unsigned long want) {
+  unsigned long capacity = queue->mask + 1;
+  if (capacity - (tail - queue->head_cache) < want) {
+    queue->head_cache = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+  }
+  return capacity - (tail - queue->head_cache);
+}
+
+/*
+ * Auxilliary function, called by the consumer, to return the number of values
+ * in a queue, reloading the producer's `tail` only if its cached copy shows
+ * fewer than `want` values.
+ */
+static inline unsigned long _spscqueue_used_slots(struct spscqueue* queue,
+    unsigned long head, unsigned long want) {
+  if (queue->tail_cache - head < want) {
+    queue->tail_cache = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+  }
+  return queue->tail_cache - head;
+}
+
+/*
+ * This function enqueues a new value into a given SPSC queue.  It may only be
+ * called by the producer.
+ *
+ * Params:
+ *   queue - the SPSC queue into which a value is to be enqueued.  May not be
+ *     NULL.
+ *   val - the value to be enqueued.
+ *
+ * Return:
+ *   This function returns 1 if the value was enqueued, or 0 if the queue was
+ *   full.
+ */
+int spscqueue_enqueue(struct spscqueue* queue, void* val) {
+  assert(queue);
+  unsigned long tail = queue->tail;
+  if (!_spscqueue_free_slots(queue, tail, 1)) {
+    return 0;
+  }
+  queue->vals[tail & queue->mask] = val;
+  __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+/*
+ * This function enqueues as many as possible of an array of values into a
+ * given SPSC queue, in order.  The values are copied into the ring with at
+ * most two memcpy()s and published to the consumer all at once.  It may only
+ * be called by the producer.
+ *
+ * Params:
+ *   queue - the SPSC queue into which values are to be enqueued.  May not be
+ *     NULL.
+ *   vals - the values to be enqueued.  May not be NULL unless `n` is 0.
+ *   n - the number of values in `vals`.
+ *
+ * Return:
+ *   This function returns the number of values enqueued, which is less than
+ *   `n` if the queue filled up.
+ */
+int spscqueue_enqueue_n(struct spscqueue* queue, void** vals, int n) {
+  assert(queue && n >= 0);
+  unsigned long tail = queue->tail;
+  unsigned long count = _spscqueue_free_slots(queue, tail, n);
+  if (count > (unsigned long)n) {
+    count = n;
+  }
+  if (!count) {
+    return 0;
+  }
+
+  unsigned long start = tail & queue->mask;
+  unsigned long first = queue->mask + 1 - start;
+  if (first > count) {
+    first = count;
+  }
+  memcpy(queue->vals + start, vals, first * sizeof(void*));
+  memcpy(queue->vals, vals + first, (count - first) * sizeof(void*));
+  __atomic_store_n(&queue->tail, tail + count, __ATOMIC_RELEASE);
+  return (int)count;
+}
+
+/*
+ * This function returns the value at the front of a given SPSC queue without
+ * removing it, or NULL if the queue is empty.  It may only be called by the
+ * consumer.
+ *
+ * Params:
+ *   queue - the SPSC queue from which to query the front value.  May not be
+ *     NULL.
+ */
+void* spscqueue_front(struct spscqueue* queue) {
+  assert(queue);
+  unsigned long head = queue->head;
+  if (!_spscqueue_used_slots(queue, head, 1)) {
+    return NULL;
+  }
+  return queue->vals[head & queue->mask];
+}
+
+/*
+ * This function dequeues a value from a given SPSC queue and returns it, or
+ * returns NULL if the queue is empty (so NULL values can't be told apart from
+ * an empty queue; use spscqueue_dequeue_n() for that).  It may only be called
+ * by the consumer.
+ *
+ * Params:
+ *   queue - the SPSC queue from which a value is to be dequeued.  May not be
+ *     NULL.
+ *
+ * Return:
+ *   This function returns the value that was dequeued.
+ */
+void* spscqueue_dequeue(struct spscqueue* queue) {
+  assert(queue);
+  unsigned long head = queue->head;
+  if (!_spscqueue_used_slots(queue, head, 1)) {
+    return NULL;
+  }
+  void* val = queue->vals[head & queue->mask];
+  __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+  return val;
+}
+
+/*
+ * This function dequeues as many values as are available from a given SPSC
+ * queue, up to `n`, into an array, in order.  The slots are handed back to
+ * the producer all at once.  It may only be called by the consumer.
+ *
+ * Params:
+ *   queue - the SPSC queue from which values are to be dequeued.  May not be
+ *     NULL.
+ *   vals - the array into which to copy the dequeued values.  May not be NULL
+ *     unless `n` is 0.
+ *   n - the most values to dequeue.
+ *
+ * Return:
+ *   This function returns the number of values dequeued, which is 0 if the
+ *   queue was empty.
+ */
+int spscqueue_dequeue_n(struct spscqueue* queue, void** vals, int n) {
+  assert(queue && n >= 0);
+  unsigned long head = queue->head;
+  unsigned long count = _spscqueue_used_slots(queue, head, n);
+  if (count > (unsigned long)n) {
+    count = n;
+  }
+  if (!count) {
+    return 0;
+  }
+
+  unsigned long start = head & queue->mask;
+  unsigned long first = queue->mask + 1 - start;
+  if (first > count) {
+    first = count;
+  }
+  memcpy(vals, queue->vals + start, first * sizeof(void*));
+  memcpy(vals + first, queue->vals, (count - first) * sizeof(void*));
+  __atomic_store_n(&queue->head, head + count, __ATOMIC_RELEASE);
+  return (int)count;
+}
@@ -0,0 +1,33 @@
+/*
+ * This file contains the definition of the interface for a single-producer,
+ * single-consumer (SPSC) queue: a bounded queue, stored in a ring buffer,
+ * that one thread can enqueue into while another thread dequeues from it,
+ * without a lock.  It supports the same operations as the queue in queue.h,
+ * plus batch versions of enqueue and dequeue.  You can find descriptions of
+ * the SPSC queue functions, including their parameters and their return
+ * values, in spscqueue.c.
+ */
+
+#ifndef __SPSCQUEUE_H
+#define __SPSCQUEUE_H
+
+/*
+ * Structure used to represent an SPSC queue.
+ */
+struct spscqueue;
+
+/*
+ * SPSC queue interface function prototypes.  Refer to spscqueue.c for
+ * documentation about each of these functions.
+ */
+struct spscqueue* spscqueue_create(int capacity);
+void spscqueue_free(struct spscqueue* queue);
+int spscqueue_capacity(struct spscqueue* queue);
+int spscqueue_isempty(struct spscqueue* queue);
+int spscqueue_enqueue(struct spscqueue* queue, void* val);
+int spscqueue_enqueue_n(struct spscqueue* queue, void** vals, int n);
+void* spscqueue_front(struct spscqueue* queue);
+void* spscqueue_dequeue(struct spscqueue* queue);
+int spscqueue_dequeue_n(struct spscqueue* queue, void** vals, int n);
+
+#endif
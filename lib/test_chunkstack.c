@@ -0,0 +1,108 @@
+/*
+ * This is a small program to test the chunked stack implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "chunkstack.h"
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Function to run tests on the chunked stack, pushing and popping up to `n`
+ * values.
+ */
+void test_chunkstack(int n) {
+  struct chunkstack cs;
+  int* vals;
+  int i, j, ok;
+
+  printf("== Chunked stack\n");
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  chunkstack_init(&cs);
+  printf("Checking that a new stack is empty... ");
+  check(chunkstack_isempty(&cs) && chunkstack_top(&cs) == NULL
+      && chunkstack_pop(&cs) == NULL);
+
+  printf("Pushing %d values... ", n);
+  ok = 1;
+  for (i = 0; ok && i < n; i++) {
+    chunkstack_push(&cs, &vals[i]);
+    ok = chunkstack_top(&cs) == &vals[i] && chunkstack_size(&cs) == i + 1;
+  }
+  check(ok);
+
+  printf("Popping half of them... ");
+  for (i = n - 1; ok && i >= n / 2; i--) {
+    ok = chunkstack_pop(&cs) == &vals[i];
+  }
+  check(ok && chunkstack_size(&cs) == n / 2);
+
+  printf("Pushing and popping back and forth across chunk ends... ");
+  for (j = 1; ok && j < 100; j++) {
+    for (i = n / 2; i < n / 2 + j; i++) {
+      chunkstack_push(&cs, &vals[i]);
+    }
+    for (i = n / 2 + j - 1; ok && i >= n / 2 - j; i--) {
+      ok = chunkstack_pop(&cs) == &vals[i];
+    }
+    for (i = n / 2 - j; i < n / 2; i++) {
+      chunkstack_push(&cs, &vals[i]);
+    }
+  }
+  check(ok && chunkstack_top(&cs) == &vals[n / 2 - 1]);
+
+  printf("Rolling back to checkpoints across chunk ends... ");
+  for (j = 0; ok && j * j < n / 2; j++) {
+    int mark = n / 2 - j * j;
+    int top = chunkstack_mark(&cs);
+    for (i = n / 2; i < n; i++) {
+      chunkstack_push(&cs, &vals[i]);
+    }
+    chunkstack_rollback(&cs, top);
+    ok = chunkstack_size(&cs) == n / 2
+      && chunkstack_top(&cs) == &vals[n / 2 - 1];
+    chunkstack_rollback(&cs, mark);
+    ok = ok && chunkstack_size(&cs) == mark
+      && chunkstack_top(&cs) == (mark ? &vals[mark - 1] : NULL);
+    for (i = mark; i < n / 2; i++) {
+      chunkstack_push(&cs, &vals[i]);
+    }
+  }
+  check(ok && chunkstack_top(&cs) == &vals[n / 2 - 1]);
+
+  printf("Popping the rest... ");
+  for (i = n / 2 - 1; ok && i >= 0; i--) {
+    ok = chunkstack_pop(&cs) == &vals[i];
+  }
+  check(ok && chunkstack_isempty(&cs) && chunkstack_pop(&cs) == NULL);
+
+  printf("Destroying and reusing the stack... ");
+  chunkstack_push(&cs, &vals[0]);
+  chunkstack_destroy(&cs);
+  ok = chunkstack_isempty(&cs);
+  chunkstack_push(&cs, &vals[1]);
+  ok = ok && chunkstack_pop(&cs) == &vals[1];
+  chunkstack_destroy(&cs);
+  check(ok);
+
+  free(vals);
+}
+
+int main(int argc, char** argv) {
+  test_chunkstack(100000);
+  return 0;
+}
@@ -0,0 +1,820 @@
+/*
+ * This is a small program to test the dynamic array implementations.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "dynarray.h"
+#include "dynarray_typed.h"
+#include "dynarray_seg.h"
+#include "dynarray_scan.h"
+#include "dynarray_sort.h"
+
+DYNARRAY_DECLARE(int, int)
+DYNARRAY_DECLARE_INT_SEARCH(int)
+
+/*
+ * Struct used to check that typed dynamic arrays store whole structs by
+ * value.
+ */
+struct point {
+  int x;
+  int y;
+};
+
+DYNARRAY_DECLARE(point, struct point)
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Function to run tests on the typed dynamic array.
+ */
+void test_dynarray_typed(int n) {
+  struct dynarray_int* da;
+  struct dynarray_point* pts;
+  struct point p;
+  int i, ok;
+
+  printf("== Typed dynamic array\n");
+  da = dynarray_int_create();
+  printf("Checking that array is not NULL... ");
+  check(da != NULL);
+
+  for (i = 0; i < n; i++) {
+    dynarray_int_insert(da, i * i);
+  }
+  printf("Checking array size (%d == %d?)... ", n, dynarray_int_size(da));
+  check(dynarray_int_size(da) == n);
+
+  printf("Checking array contents... ");
+  ok = 1;
+  for (i = 0; i < n; i++) {
+    if (dynarray_int_get(da, i) != i * i)
+      ok = 0;
+  }
+  check(ok);
+
+  printf("Checking that elements are stored contiguously... ");
+  check(dynarray_int_at(da, n - 1) - dynarray_int_at(da, 0) == n - 1);
+
+  printf("Replacing and removing every other element... ");
+  for (i = 0; i < n; i += 2) {
+    dynarray_int_set(da, i, -1);
+  }
+  for (i = n - 2 + n % 2; i >= 0; i -= 2) {
+    dynarray_int_remove(da, i);
+  }
+  ok = dynarray_int_size(da) == n / 2;
+  for (i = 0; ok && i < dynarray_int_size(da); i++) {
+    if (dynarray_int_get(da, i) != (2 * i + 1) * (2 * i + 1))
+      ok = 0;
+  }
+  check(ok);
+  dynarray_int_free(da);
+
+  pts = dynarray_point_create();
+  for (i = 0; i < n; i++) {
+    p.x = i;
+    p.y = -i;
+    dynarray_point_insert(pts, p);
+  }
+  printf("Updating struct elements in place... ");
+  for (i = 0; i < n; i++) {
+    dynarray_point_at(pts, i)->y += 2 * i;
+  }
+  ok = 1;
+  for (i = 0; i < n; i++) {
+    p = dynarray_point_get(pts, i);
+    if (p.x != i || p.y != i)
+      ok = 0;
+  }
+  check(ok);
+  dynarray_point_free(pts);
+}
+
+/*
+ * Returns 1 if the contents of `da` match the first `n` values of `expected`
+ * (compared by pointer) and 0 otherwise.
+ */
+int matches(struct dynarray* da, int** expected, int n) {
+  if (dynarray_size(da) != n)
+    return 0;
+  for (int i = 0; i < n; i++) {
+    if (dynarray_get(da, i) != expected[i])
+      return 0;
+  }
+  return 1;
+}
+
+/*
+ * Function to run tests on the bulk insertion and capacity functions of both
+ * the void* and the typed dynamic arrays.
+ */
+void test_dynarray_bulk(int n) {
+  struct dynarray* da;
+  struct dynarray_int* tda;
+  int* vals;
+  void** ptrs;
+  int i, ok;
+
+  printf("\n== Bulk insertion\n");
+  vals = malloc(n * sizeof(int));
+  ptrs = malloc(n * sizeof(void*));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+    ptrs[i] = &vals[i];
+  }
+
+  da = dynarray_create();
+  dynarray_reserve(da, n);
+  printf("Appending %d values in one call... ", n / 2);
+  dynarray_append_n(da, ptrs, n / 2);
+  ok = dynarray_size(da) == n / 2;
+  for (i = 0; ok && i < n / 2; i++) {
+    ok = dynarray_get(da, i) == ptrs[i];
+  }
+  check(ok);
+
+  printf("Inserting a range into the middle... ");
+  dynarray_insert_range(da, n / 4, ptrs + n / 2, n - n / 2);
+  ok = dynarray_size(da) == n;
+  for (i = 0; ok && i < n; i++) {
+    if (i < n / 4)
+      ok = dynarray_get(da, i) == ptrs[i];
+    else if (i < n / 4 + n - n / 2)
+      ok = dynarray_get(da, i) == ptrs[n / 2 + i - n / 4];
+    else
+      ok = dynarray_get(da, i) == ptrs[i - (n - n / 2)];
+  }
+  check(ok);
+
+  printf("Shrinking to fit and inserting again... ");
+  for (i = 0; i < n / 2; i++) {
+    dynarray_remove(da, dynarray_size(da) - 1);
+  }
+  dynarray_shrink_to_fit(da);
+  dynarray_insert(da, ptrs[0]);
+  check(dynarray_size(da) == n - n / 2 + 1 &&
+      dynarray_get(da, dynarray_size(da) - 1) == ptrs[0] &&
+      dynarray_get(da, 0) == ptrs[0]);
+  dynarray_free(da);
+
+  tda = dynarray_int_create();
+  dynarray_int_reserve(tda, n);
+  printf("Typed append and insert range... ");
+  dynarray_int_append_n(tda, vals, n / 2);
+  dynarray_int_insert_range(tda, 0, vals + n / 2, n - n / 2);
+  ok = dynarray_int_size(tda) == n && tda->capacity == n;
+  for (i = 0; ok && i < n; i++) {
+    ok = dynarray_int_get(tda, i) == (i + n / 2) % n;
+  }
+  check(ok);
+
+  printf("Typed shrink to fit... ");
+  dynarray_int_remove(tda, 0);
+  dynarray_int_shrink_to_fit(tda);
+  check(tda->capacity == n - 1 && dynarray_int_get(tda, n - 2) == n / 2 - 1);
+  dynarray_int_free(tda);
+
+  free(ptrs);
+  free(vals);
+}
+
+/*
+ * Function to run tests on dynamic arrays that start out storing their
+ * elements inline and then spill over into separate storage.
+ */
+void test_dynarray_small(int n) {
+  struct dynarray* da;
+  int* vals;
+  int i, j, ok;
+
+  printf("\n== Small dynamic arrays\n");
+  vals = malloc(n * sizeof(int));
+
+  printf("Filling arrays created with capacity 1 to %d past capacity... ", n);
+  ok = 1;
+  for (i = 1; i <= n; i++) {
+    da = dynarray_create_with_capacity(i);
+    for (j = 0; j < n; j++) {
+      dynarray_insert(da, &vals[j]);
+    }
+    for (j = 0; ok && j < n; j++) {
+      ok = dynarray_get(da, j) == &vals[j];
+    }
+    dynarray_free(da);
+  }
+  check(ok);
+
+  printf("Shrinking a spilled array back into inline storage... ");
+  da = dynarray_create();
+  for (j = 0; j < n; j++) {
+    dynarray_insert(da, &vals[j]);
+  }
+  for (j = n - 1; j >= 2; j--) {
+    dynarray_remove(da, j);
+  }
+  dynarray_shrink_to_fit(da);
+  dynarray_set(da, 1, &vals[n - 1]);
+  dynarray_insert(da, &vals[0]);
+  check(dynarray_size(da) == 3 && dynarray_get(da, 0) == &vals[0]
+      && dynarray_get(da, 1) == &vals[n - 1] && dynarray_get(da, 2) == &vals[0]);
+  dynarray_free(da);
+
+  free(vals);
+}
+
+/*
+ * Function to run tests on a dynamic array large enough that its storage is
+ * mapped with mmap() rather than allocated with malloc().
+ */
+void test_dynarray_large(int n) {
+  struct dynarray* da;
+  int vals[2];
+  int i, ok;
+
+  printf("\n== Large dynamic array\n");
+  da = dynarray_create();
+  printf("Inserting %d values... ", n);
+  for (i = 0; i < n; i++) {
+    dynarray_insert(da, &vals[i % 2]);
+  }
+  ok = dynarray_size(da) == n;
+  for (i = 0; ok && i < n; i++) {
+    ok = dynarray_get(da, i) == &vals[i % 2];
+  }
+  check(ok);
+
+  printf("Reserving more room and appending... ");
+  dynarray_reserve(da, 2 * n + 1);
+  dynarray_insert(da, &vals[0]);
+  ok = dynarray_size(da) == n + 1 && dynarray_get(da, n) == &vals[0];
+  for (i = 0; ok && i < n; i++) {
+    ok = dynarray_get(da, i) == &vals[i % 2];
+  }
+  check(ok);
+
+  printf("Shrinking back to a small array... ");
+  while (dynarray_size(da) > 16) {
+    dynarray_remove(da, dynarray_size(da) - 1);
+  }
+  dynarray_shrink_to_fit(da);
+  dynarray_insert(da, &vals[1]);
+  ok = dynarray_size(da) == 17 && dynarray_get(da, 16) == &vals[1];
+  for (i = 0; ok && i < 16; i++) {
+    ok = dynarray_get(da, i) == &vals[i % 2];
+  }
+  check(ok);
+
+  dynarray_free(da);
+}
+
+/*
+ * Comparison function for typed point arrays; points are equal if both of
+ * their coordinates are.
+ */
+int point_cmp(struct point const* a, struct point const* b) {
+  return a->x != b->x || a->y != b->y;
+}
+
+/*
+ * Comparison function for void* arrays holding pointers to ints; compares
+ * the ints themselves.
+ */
+int int_ptr_cmp(void* a, void* b) {
+  return *(int*)a != *(int*)b;
+}
+
+/*
+ * Predicate for void* arrays holding pointers to ints; true if the int is
+ * odd.  Counts its calls in the int `ctx` points to.
+ */
+int int_ptr_is_odd(void* val, void* ctx) {
+  (*(int*)ctx)++;
+  return *(int*)val % 2 != 0;
+}
+
+/*
+ * Predicate for typed point arrays; true if the point's x coordinate is less
+ * than the int `ctx` points to.
+ */
+int point_x_below(struct point const* p, void* ctx) {
+  return p->x < *(int*)ctx;
+}
+
+/*
+ * Function to run tests on searching and removing by value.  The vectorized
+ * kernels are checked against plain loops for every length up to `n` and
+ * every position of the match, so all of the leftover-element cases are
+ * covered.
+ */
+void test_dynarray_scan(int n) {
+  struct dynarray* da;
+  struct dynarray_int* ints;
+  struct dynarray_point* pts;
+  struct point p;
+  int* vals;
+  void** ptrs;
+  int i, j, len, expect, count, ok;
+
+  printf("\n== Searching\n");
+  vals = malloc(n * sizeof(int));
+  ptrs = malloc(n * sizeof(void*));
+
+  printf("Finding ints at every position of arrays up to %d long... ", n);
+  ok = 1;
+  for (len = 0; len <= n; len++) {
+    for (j = -1; j < len; j++) {
+      for (i = 0; i < len; i++) {
+        vals[i] = i == j ? -7 : i;
+      }
+      ok = ok && dynarray_scan_find_int(vals, len, -7) == j
+          && dynarray_scan_count_int(vals, len, -7) == (j >= 0);
+    }
+  }
+  check(ok);
+
+  printf("Finding pointers at every position of arrays up to %d long... ", n);
+  ok = 1;
+  for (len = 0; len <= n; len++) {
+    for (j = -1; j < len; j++) {
+      for (i = 0; i < len; i++) {
+        ptrs[i] = i == j ? (void*)vals : &vals[i % 2 + 1];
+      }
+      ok = ok && dynarray_scan_find_ptr(ptrs, len, vals) == j
+          && dynarray_scan_count_ptr(ptrs, len, vals) == (j >= 0);
+    }
+  }
+  check(ok);
+
+  printf("Telling apart pointers that share their low half... ");
+  ptrs[0] = (void*)((unsigned long)vals ^ (1UL << 40));
+  ptrs[1] = vals;
+  check(dynarray_scan_find_ptr(ptrs, 2, vals) == 1);
+
+  printf("Counting and finding in a dynamic array... ");
+  da = dynarray_create();
+  expect = 0;
+  for (i = 0; i < n; i++) {
+    vals[i] = i % 3;
+    dynarray_insert(da, i % 5 == 4 ? (void*)&vals[0] : (void*)&vals[i]);
+    expect += i % 5 == 4;
+  }
+  count = 0;
+  for (i = 0; i < n; i++) {
+    count += *(int*)dynarray_get(da, i) == 0;
+  }
+  check(dynarray_find(da, &vals[0], NULL) == 0
+      && dynarray_count(da, &vals[0], NULL) == expect + 1
+      && dynarray_find(da, &vals[2], int_ptr_cmp) == 2
+      && dynarray_count(da, &vals[0], int_ptr_cmp) == count
+      && dynarray_find(da, NULL, NULL) == -1);
+
+  printf("Removing every matching element... ");
+  i = dynarray_remove_all(da, &vals[0], NULL);
+  ok = i == expect + 1 && dynarray_size(da) == n - expect - 1;
+  for (i = 0; ok && i < dynarray_size(da); i++) {
+    ok = dynarray_get(da, i) != &vals[0];
+    if (i > 0)
+      ok = ok && dynarray_get(da, i - 1) < dynarray_get(da, i);
+  }
+  j = dynarray_size(da);
+  i = count - expect - 1;
+  ok = ok && dynarray_remove_all(da, &vals[0], int_ptr_cmp) == i
+      && dynarray_size(da) == j - i
+      && dynarray_count(da, &vals[0], int_ptr_cmp) == 0;
+  check(ok);
+  dynarray_free(da);
+
+  /*
+   * Advance the head three quarters of the way along the buffer before
+   * filling it, so the elements wrap around its end.
+   */
+  printf("Removing odd elements from a wrapped array in one pass... ");
+  da = dynarray_create_with_capacity(n);
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+  for (i = 0; i < 3 * n / 4; i++) {
+    dynarray_insert(da, &vals[i]);
+    dynarray_remove_front(da);
+  }
+  for (i = 0; i < n; i++) {
+    dynarray_insert(da, &vals[i]);
+  }
+  count = 0;
+  ok = da->head + dynarray_size(da) > da->capacity
+      && dynarray_remove_if(da, int_ptr_is_odd, &count) == n / 2
+      && count == n && dynarray_size(da) == n - n / 2;
+  for (i = 0; ok && i < dynarray_size(da); i++) {
+    ok = dynarray_get(da, i) == &vals[2 * i];
+  }
+  check(ok);
+  dynarray_free(da);
+
+  printf("Finding and counting in a typed array of ints... ");
+  ints = dynarray_int_create();
+  for (i = 0; i < n; i++) {
+    dynarray_int_insert(ints, i % 7);
+  }
+  ok = dynarray_int_find_int(ints, 5) == 5
+      && dynarray_int_count_int(ints, 5) == (n + 1) / 7
+      && dynarray_int_find_int(ints, 7) == -1
+      && dynarray_int_count_int(ints, 7) == 0;
+  dynarray_int_set(ints, n - 1, 7);
+  ok = ok && dynarray_int_find_int(ints, 7) == n - 1
+      && dynarray_int_count_int(ints, 7) == 1;
+  check(ok);
+  dynarray_int_free(ints);
+
+  printf("Searching and removing typed struct elements... ");
+  pts = dynarray_point_create();
+  for (i = 0; i < n; i++) {
+    p.x = i % 4;
+    p.y = i % 3;
+    dynarray_point_insert(pts, p);
+  }
+  p.x = 1;
+  p.y = 2;
+  count = dynarray_point_count(pts, &p, point_cmp);
+  ok = dynarray_point_find(pts, &p, point_cmp) == 5
+      && dynarray_point_remove_all(pts, &p, point_cmp) == count
+      && dynarray_point_size(pts) == n - count
+      && dynarray_point_find(pts, &p, point_cmp) == -1;
+  for (i = 0; ok && i < 5; i++) {
+    ok = dynarray_point_get(pts, i).x == i % 4
+        && dynarray_point_get(pts, i).y == i % 3;
+  }
+  check(ok);
+
+  printf("Removing typed struct elements with a predicate... ");
+  j = 2;
+  count = dynarray_point_size(pts);
+  ok = dynarray_point_remove_if(pts, point_x_below, &j) == count - n / 2;
+  for (i = 0, j = 0; ok && i < n; i++) {
+    if (i % 4 >= 2) {
+      ok = j < dynarray_point_size(pts)
+          && dynarray_point_get(pts, j).x == i % 4
+          && dynarray_point_get(pts, j).y == i % 3;
+      j++;
+    }
+  }
+  check(ok && j == dynarray_point_size(pts));
+  dynarray_point_free(pts);
+
+  free(ptrs);
+  free(vals);
+}
+
+/*
+ * Comparison functions for sorting.  The first orders void* pointers to ints
+ * by the ints' values and the second orders points by x, then y.
+ */
+int int_ptr_order(void* a, void* b) {
+  int x = *(int*)a, y = *(int*)b;
+  return (x > y) - (x < y);
+}
+
+int point_order(struct point const* a, struct point const* b) {
+  if (a->x != b->x)
+    return (a->x > b->x) - (a->x < b->x);
+  return (a->y > b->y) - (a->y < b->y);
+}
+
+/*
+ * Returns 1 if the ints pointed to by the first `n` elements of `da` are in
+ * ascending order and every element still points into `vals[0..n)` exactly
+ * once; returns 0 otherwise.
+ */
+int check_sorted(struct dynarray* da, int* vals, int n) {
+  char* seen = calloc(n, 1);
+  int i, idx, ok = dynarray_size(da) == n;
+  for (i = 0; ok && i < n; i++) {
+    idx = (int*)dynarray_get(da, i) - vals;
+    ok = idx >= 0 && idx < n && !seen[idx];
+    if (ok)
+      seen[idx] = 1;
+    if (ok && i > 0)
+      ok = int_ptr_order(dynarray_get(da, i - 1), dynarray_get(da, i)) <= 0;
+  }
+  free(seen);
+  return ok;
+}
+
+/*
+ * Function to run tests on sorting.  Arrays of `n` elements are sorted with
+ * the introsort; arrays of `big` elements are large enough to be sorted on
+ * multiple threads.
+ */
+void test_dynarray_sort(int n, int big) {
+  struct dynarray* da;
+  struct dynarray_point* pts;
+  struct point p;
+  int* vals;
+  int i, len, pattern, ok;
+
+  printf("\n== Sorting\n");
+  vals = malloc(big * sizeof(int));
+
+  printf("Sorting random arrays of every length up to %d... ", n);
+  ok = 1;
+  for (len = 0; len <= n; len++) {
+    da = dynarray_create();
+    for (i = 0; i < len; i++) {
+      vals[i] = rand() % (len / 2 + 1);
+      dynarray_insert(da, &vals[i]);
+    }
+    dynarray_sort(da, int_ptr_order);
+    ok = ok && check_sorted(da, vals, len);
+    dynarray_free(da);
+  }
+  check(ok);
+
+  printf("Sorting sorted, reversed, equal and sawtooth arrays... ");
+  ok = 1;
+  for (pattern = 0; pattern < 4; pattern++) {
+    da = dynarray_create();
+    for (i = 0; i < 10 * n; i++) {
+      if (pattern == 0)
+        vals[i] = i;
+      else if (pattern == 1)
+        vals[i] = -i;
+      else if (pattern == 2)
+        vals[i] = 7;
+      else
+        vals[i] = i % 17;
+      dynarray_insert(da, &vals[i]);
+    }
+    dynarray_sort(da, int_ptr_order);
+    ok = ok && check_sorted(da, vals, 10 * n);
+    dynarray_free(da);
+  }
+  check(ok);
+
+  printf("Sorting %d values on multiple threads... ", big);
+  da = dynarray_create();
+  for (i = 0; i < big; i++) {
+    vals[i] = rand() - RAND_MAX / 2;
+    dynarray_insert(da, &vals[i]);
+  }
+  dynarray_sort(da, int_ptr_order);
+  check(check_sorted(da, vals, big));
+  dynarray_free(da);
+
+  printf("Radix sorting %d ints, including negative ones... ", big);
+  for (i = 0; i < big; i++) {
+    vals[i] = i % 3 == 0 ? rand() - RAND_MAX / 2 : rand() % 1000 - 500;
+  }
+  dynarray_sort_radix(vals, big, sizeof(int), 0);
+  ok = 1;
+  for (i = 1; ok && i < big; i++) {
+    ok = vals[i - 1] <= vals[i];
+  }
+  check(ok);
+
+  printf("Radix sorting points by x, keeping them in order of y... ");
+  pts = dynarray_point_create();
+  for (i = 0; i < n * n; i++) {
+    p.x = (n - i % n) * 1000;
+    p.y = i;
+    dynarray_point_insert(pts, p);
+  }
+  dynarray_sort_radix(pts->data, dynarray_point_size(pts),
+      sizeof(struct point), offsetof(struct point, x));
+  ok = 1;
+  for (i = 1; ok && i < n * n; i++) {
+    ok = point_order(dynarray_point_at(pts, i - 1),
+        dynarray_point_at(pts, i)) < 0;
+  }
+  check(ok);
+
+  printf("Sorting typed points by x, then y... ");
+  for (i = 0; i < n * n; i++) {
+    dynarray_point_at(pts, i)->y = rand() % n;
+  }
+  dynarray_point_sort(pts, point_order);
+  ok = dynarray_point_size(pts) == n * n;
+  for (i = 1; ok && i < n * n; i++) {
+    ok = point_order(dynarray_point_at(pts, i - 1),
+        dynarray_point_at(pts, i)) <= 0;
+  }
+  check(ok);
+  dynarray_point_free(pts);
+
+  free(vals);
+}
+
+/*
+ * Function to run tests on using the dynamic array as a deque, in particular
+ * inserting and removing at both ends and indexing into, searching, sorting
+ * and bulk inserting into an array that has wrapped around.
+ */
+void test_dynarray_deque(int n) {
+  int i, ok;
+  int* test_data;
+  int** sim;
+  struct dynarray* da;
+
+  printf("\n== Deque operations\n");
+  test_data = malloc(n * sizeof(int));
+  sim = malloc(n * sizeof(int*));
+  for (i = 0; i < n; i++) {
+    test_data[i] = i;
+  }
+
+  /*
+   * Insert at both ends: odd values at the front, even values at the end.
+   * The simulated array is built from the middle outward.
+   */
+  da = dynarray_create();
+  printf("Inserting %d values at alternating ends... ", n);
+  for (i = 0; i < n; i++) {
+    if (i % 2)
+      dynarray_insert_front(da, &test_data[i]);
+    else
+      dynarray_insert(da, &test_data[i]);
+  }
+  for (i = 0; i < n / 2; i++) {
+    sim[i] = &test_data[n - 1 - 2 * i];
+    sim[n / 2 + i] = &test_data[2 * i];
+  }
+  check(matches(da, sim, n));
+
+  printf("Removing from both ends... ");
+  for (i = 0; i < n / 4; i++) {
+    int* front = dynarray_remove_front(da);
+    int* end = dynarray_remove_end(da);
+    if (front != sim[i] || end != sim[n - 1 - i])
+      break;
+  }
+  check(i == n / 4 && matches(da, sim + n / 4, n - 2 * (n / 4)));
+
+  /*
+   * Rebuild the array so that it wraps around the end of its buffer, then
+   * check that set and remove at arbitrary indices see the right elements.
+   */
+  dynarray_free(da);
+  da = dynarray_create();
+  for (i = 0; i < 6; i++) {
+    dynarray_insert(da, &test_data[i]);
+  }
+  for (i = 0; i < 4; i++) {
+    dynarray_remove_front(da);
+  }
+  for (i = 6; i < 12; i++) {
+    dynarray_insert(da, &test_data[i]);
+  }
+
+  printf("Searching a wrapped array... ");
+  check(dynarray_find(da, &test_data[11], NULL) == 7
+      && dynarray_find(da, &test_data[5], NULL) == 1
+      && dynarray_count(da, &test_data[3], NULL) == 0);
+
+  printf("Setting values in a wrapped array... ");
+  for (i = 0; i < dynarray_size(da); i++) {
+    dynarray_set(da, i, &test_data[100 + i]);
+    sim[i] = &test_data[100 + i];
+  }
+  check(matches(da, sim, 8));
+
+  printf("Removing from the middle of a wrapped array... ");
+  dynarray_remove(da, 2);
+  dynarray_remove(da, 5);
+  sim[0] = &test_data[100];
+  sim[1] = &test_data[101];
+  sim[2] = &test_data[103];
+  sim[3] = &test_data[104];
+  sim[4] = &test_data[105];
+  sim[5] = &test_data[107];
+  check(matches(da, sim, 6));
+
+  printf("Bulk inserting into and sorting a wrapped array... ");
+  dynarray_insert_front(da, &test_data[99]);
+  dynarray_insert_front(da, &test_data[98]);
+  dynarray_insert_range(da, 3, (void**)sim, 2);
+  dynarray_append_n(da, (void**)sim, 1);
+  dynarray_sort(da, int_ptr_order);
+  ok = dynarray_size(da) == 11 && dynarray_get(da, 0) == &test_data[98];
+  for (i = 1; ok && i < 11; i++) {
+    ok = int_ptr_order(dynarray_get(da, i - 1), dynarray_get(da, i)) <= 0;
+  }
+  check(ok);
+
+  /*
+   * Use the array as a queue whose contents wrap around the end of its
+   * buffer, moving values in and out in blocks.
+   */
+  dynarray_free(da);
+  da = dynarray_create_with_capacity(8);
+  for (i = 0; i < 6; i++) {
+    dynarray_insert(da, &test_data[i]);
+  }
+  for (i = 0; i < 4; i++) {
+    dynarray_remove_front(da);
+  }
+  for (i = 0; i < 5; i++) {
+    sim[i] = &test_data[6 + i];
+  }
+
+  printf("Appending a block that wraps around the buffer... ");
+  dynarray_append_n(da, (void**)sim, 5);
+  check(dynarray_size(da) == 7 && dynarray_get(da, 0) == &test_data[4]
+      && dynarray_get(da, 6) == &test_data[10]);
+
+  printf("Removing blocks from the front of a wrapped array... ");
+  ok = dynarray_remove_front_n(da, (void**)sim, 5) == 5;
+  for (i = 0; ok && i < 5; i++) {
+    ok = sim[i] == &test_data[4 + i];
+  }
+  ok = ok && dynarray_remove_front_n(da, (void**)sim, 5) == 2
+    && sim[0] == &test_data[9] && sim[1] == &test_data[10];
+  check(ok && dynarray_size(da) == 0
+      && dynarray_remove_front_n(da, (void**)sim, 5) == 0);
+
+  dynarray_free(da);
+  free(sim);
+  free(test_data);
+}
+
+/*
+ * Function to run tests on the segmented dynamic array.
+ */
+void test_dynarray_seg(int n) {
+  struct dynarray_seg* da;
+  int* vals;
+  void** first;
+  void** mid;
+  int i, ok;
+
+  printf("\n== Segmented dynamic array\n");
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  da = dynarray_seg_create();
+  printf("Checking that array is not NULL... ");
+  check(da != NULL);
+
+  for (i = 0; i < n / 2; i++) {
+    dynarray_seg_insert(da, &vals[i]);
+  }
+  first = dynarray_seg_at(da, 0);
+  mid = dynarray_seg_at(da, n / 2 - 1);
+  for (i = n / 2; i < n; i++) {
+    dynarray_seg_insert(da, &vals[i]);
+  }
+  printf("Checking array size (%d == %d?)... ", n, dynarray_seg_size(da));
+  check(dynarray_seg_size(da) == n);
+
+  printf("Checking array contents... ");
+  ok = 1;
+  for (i = 0; i < n; i++) {
+    if (dynarray_seg_get(da, i) != &vals[i])
+      ok = 0;
+  }
+  check(ok);
+
+  printf("Checking that growing did not move elements... ");
+  check(first == dynarray_seg_at(da, 0) && mid == dynarray_seg_at(da, n / 2 - 1)
+      && *first == &vals[0] && *mid == &vals[n / 2 - 1]);
+
+  printf("Replacing and removing every other element... ");
+  for (i = 0; i < n; i += 2) {
+    dynarray_seg_set(da, i, NULL);
+  }
+  for (i = n - 2 + n % 2; i >= 0; i -= 2) {
+    dynarray_seg_remove(da, i);
+  }
+  ok = dynarray_seg_size(da) == n / 2;
+  for (i = 0; ok && i < dynarray_seg_size(da); i++) {
+    if (dynarray_seg_get(da, i) != &vals[2 * i + 1])
+      ok = 0;
+  }
+  check(ok);
+
+  dynarray_seg_free(da);
+  free(vals);
+}
+
+int main(int argc, char** argv) {
+  test_dynarray_typed(100);
+  test_dynarray_deque(1000);
+  test_dynarray_bulk(1000);
+  test_dynarray_small(64);
+  test_dynarray_large(1 << 20);
+  test_dynarray_scan(40);
+  test_dynarray_sort(100, 1 << 18);
+  test_dynarray_seg(1000);
+  return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * This is a small program to test the flat map implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "flatmap.h"
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Returns the number of the `n` keys in `keys` that are less than `key`, by
+ * looking at every one of them.
+ */
+int count_less(int* keys, int n, int key) {
+  int i, count = 0;
+  for (i = 0; i < n; i++) {
+    count += keys[i] < key;
+  }
+  return count;
+}
+
+int main(int argc, char** argv) {
+  struct flatmap* fm;
+  int n = 1000, range = 4 * n;
+  int* keys, * vals, * present;
+  void** ptrs;
+  int i, k, first, count, ok;
+
+  keys = malloc(n * sizeof(int));
+  vals = malloc(n * sizeof(int));
+  ptrs = malloc(n * sizeof(void*));
+  present = malloc(range * sizeof(int));
+
+  /*
+   * Pick random keys, some of them repeated.  present[k] holds the index of
+   * the last pair with key k, or -1 if k wasn't picked.
+   */
+  for (k = 0; k < range; k++) {
+    present[k] = -1;
+  }
+  for (i = 0; i < n; i++) {
+    keys[i] = rand() % range;
+    vals[i] = i;
+    ptrs[i] = &vals[i];
+    present[keys[i]] = i;
+  }
+
+  printf("== Building a flat map from %d pairs\n", n);
+  fm = flatmap_create();
+  flatmap_build(fm, keys, ptrs, n);
+  count = 0;
+  for (k = 0; k < range; k++) {
+    count += present[k] >= 0;
+  }
+  printf("Checking map size (%d == %d?)... ", count, flatmap_size(fm));
+  check(flatmap_size(fm) == count);
+
+  printf("Checking that keys are sorted and unique... ");
+  ok = 1;
+  for (i = 1; ok && i < flatmap_size(fm); i++) {
+    ok = flatmap_key_at(fm, i - 1) < flatmap_key_at(fm, i);
+  }
+  check(ok);
+
+  printf("Looking up every possible key... ");
+  ok = 1;
+  for (k = -1; ok && k <= range; k++) {
+    if (k >= 0 && k < range && present[k] >= 0)
+      ok = flatmap_get(fm, k) == &vals[present[k]];
+    else
+      ok = flatmap_get(fm, k) == NULL;
+  }
+  check(ok);
+
+  printf("\n== Searching\n");
+  printf("Checking lower and upper bounds of every possible key... ");
+  for (i = 0; i < flatmap_size(fm); i++) {
+    keys[i] = flatmap_key_at(fm, i);
+  }
+  ok = 1;
+  for (k = -1; ok && k <= range; k++) {
+    ok = flatmap_lower_bound(fm, k) == count_less(keys, count, k)
+        && flatmap_upper_bound(fm, k) == count_less(keys, count, k + 1);
+  }
+  ok = ok && flatmap_lower_bound(fm, INT_MIN) == 0
+      && flatmap_upper_bound(fm, INT_MAX) == count;
+  check(ok);
+
+  printf("Scanning ranges of keys... ");
+  ok = 1;
+  for (k = 0; ok && k < range; k += 37) {
+    int n_range = flatmap_range(fm, k, k + 100, &first);
+    int expect = 0;
+    for (i = k; i <= k + 100 && i < range; i++) {
+      expect += present[i] >= 0;
+    }
+    ok = n_range == expect && first == count_less(keys, count, k);
+    for (i = first; ok && i < first + n_range; i++) {
+      ok = flatmap_value_at(fm, i) == &vals[present[flatmap_key_at(fm, i)]];
+    }
+  }
+  ok = ok && flatmap_range(fm, 10, 5, &first) == 0;
+  check(ok);
+
+  printf("\n== Updating\n");
+  printf("Inserting new keys and replacing existing ones... ");
+  flatmap_insert(fm, -5, &vals[0]);
+  flatmap_insert(fm, range + 5, &vals[1]);
+  flatmap_insert(fm, flatmap_key_at(fm, 10), &vals[2]);
+  ok = flatmap_size(fm) == count + 2 && flatmap_key_at(fm, 0) == -5
+      && flatmap_get(fm, range + 5) == &vals[1]
+      && flatmap_value_at(fm, 10) == &vals[2];
+  check(ok);
+
+  printf("Removing every key... ");
+  flatmap_remove(fm, range + 100);
+  ok = flatmap_size(fm) == count + 2;
+  while (ok && flatmap_size(fm) > 0) {
+    k = flatmap_key_at(fm, flatmap_size(fm) / 2);
+    flatmap_remove(fm, k);
+    ok = flatmap_get(fm, k) == NULL;
+  }
+  check(ok);
+
+  printf("Building from an empty set of pairs... ");
+  flatmap_build(fm, keys, ptrs, 0);
+  check(flatmap_size(fm) == 0 && flatmap_lower_bound(fm, 3) == 0);
+
+  flatmap_free(fm);
+  free(present);
+  free(ptrs);
+  free(vals);
+  free(keys);
+  return 0;
+}
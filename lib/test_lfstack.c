@@ -0,0 +1,120 @@
+/*
+ * This is a small program to test the lock-free stack implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "lfstack.h"
+
+#define NUM_THREADS 8
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Structure holding the work for one test thread: push each of `vals[0]` to
+ * `vals[n-1]` onto `stack`, popping one value after every other push, and
+ * count each popped value in `seen`, which is indexed from `base`.
+ */
+struct worker {
+  struct lfstack* stack;
+  int* vals;
+  int n;
+  int* base;
+  int* seen;
+};
+
+/*
+ * Counts `val` (a pointer into the test data starting at `base`) in `seen`.
+ */
+void count_seen(int* seen, int* base, int* val) {
+  __atomic_fetch_add(&seen[val - base], 1, __ATOMIC_RELAXED);
+}
+
+void* work(void* arg) {
+  struct worker* w = arg;
+  int i;
+  for (i = 0; i < w->n; i++) {
+    lfstack_push(w->stack, &w->vals[i]);
+    if (i % 2) {
+      int* val = lfstack_pop(w->stack);
+      if (val)
+        count_seen(w->seen, w->base, val);
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Function to run tests on a lock-free stack, first from one thread and then
+ * from NUM_THREADS threads at once, each pushing `n` values.
+ */
+void test_lfstack(struct lfstack* stack, int n) {
+  struct worker workers[NUM_THREADS];
+  pthread_t threads[NUM_THREADS];
+  int* vals, * seen, * val;
+  int i, ok, total = NUM_THREADS * n;
+
+  vals = malloc(total * sizeof(int));
+  seen = calloc(total, sizeof(int));
+  for (i = 0; i < total; i++) {
+    vals[i] = i;
+  }
+
+  printf("Checking that a new stack is empty... ");
+  check(lfstack_isempty(stack) && lfstack_top(stack) == NULL
+      && lfstack_pop(stack) == NULL);
+
+  printf("Pushing and popping %d values from one thread... ", n);
+  ok = 1;
+  for (i = 0; ok && i < n; i++) {
+    lfstack_push(stack, &vals[i]);
+    ok = lfstack_top(stack) == &vals[i];
+  }
+  for (i = n - 1; ok && i >= 0; i--) {
+    ok = lfstack_pop(stack) == &vals[i];
+  }
+  check(ok && lfstack_isempty(stack));
+
+  printf("Pushing and popping %d values each from %d threads... ", n,
+      NUM_THREADS);
+  for (i = 0; i < NUM_THREADS; i++) {
+    workers[i].stack = stack;
+    workers[i].vals = vals + i * n;
+    workers[i].n = n;
+    workers[i].base = vals;
+    workers[i].seen = seen;
+    pthread_create(&threads[i], NULL, work, &workers[i]);
+  }
+  for (i = 0; i < NUM_THREADS; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  while ((val = lfstack_pop(stack)))
+    count_seen(seen, vals, val);
+  ok = lfstack_isempty(stack);
+  for (i = 0; ok && i < total; i++) {
+    ok = seen[i] == 1;
+  }
+  check(ok);
+
+  lfstack_free(stack);
+  free(seen);
+  free(vals);
+}
+
+int main(int argc, char** argv) {
+  printf("== Lock-free stack\n");
+  test_lfstack(lfstack_create(), 100000);
+  printf("\n== Lock-free stack with elimination\n");
+  test_lfstack(lfstack_create_with_elimination(NUM_THREADS / 2), 100000);
+  return 0;
+}
@@ -0,0 +1,736 @@
+/*
+ * This is a small program to test the linked list implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "list.h"
+#include "ulist.h"
+#include "ilist.h"
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Comparison function that compares the ints pointed to by two values.
+ */
+int int_ptr_cmp(void* a, void* b) {
+  return *(int*)a != *(int*)b;
+}
+
+/*
+ * Function to run tests on reusing list nodes: the list's nodes are
+ * repeatedly removed and reinserted, so almost every node after the first
+ * round comes from the list's pool of freed nodes.
+ */
+void test_list_pool(int n, int rounds) {
+  struct list* list, * other;
+  int* vals;
+  int i, r, last, ok, pool, spare;
+
+  printf("== Node pool\n");
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  list = list_create();
+  printf("Pushing and popping %d values %d times... ", n, rounds);
+  ok = 1;
+  for (r = 0; r < rounds; r++) {
+    for (i = 0; i < n; i++) {
+      list_insert(list, &vals[i]);
+    }
+    for (i = n - 1; ok && i >= 0; i--) {
+      ok = list_head(list) == &vals[i];
+      list_remove_head(list);
+    }
+  }
+  check(ok && list_isempty(list));
+
+  printf("Refilling after removing from the middle and the end... ");
+  for (i = 0; i < n; i++) {
+    list_insert_end(list, &vals[i]);
+  }
+  for (i = 0; i < n; i += 3) {
+    list_remove(list, &vals[i], NULL);
+  }
+  list_remove_end(list);
+  for (i = 0; i < n; i += 3) {
+    list_insert(list, &vals[i]);
+  }
+  last = n - 1 - ((n - 1) % 3 == 0);
+  ok = 1;
+  for (i = 0; ok && i < n; i++) {
+    if (i % 3 == 0)
+      ok = list_position(list, &vals[i], int_ptr_cmp)
+          == (n - 1) / 3 - i / 3;
+    else if (i == last)
+      ok = list_position(list, &vals[i], NULL) == -1;
+    else
+      ok = list_position(list, &vals[i], NULL) >= (n + 2) / 3;
+  }
+  check(ok);
+
+  printf("Freeing a list with nodes both in use and free... ");
+  list_free(list);
+  printf("OK\n");
+
+  /*
+   * Every node of the pool that isn't in the list should be reusable, so
+   * refilling the list up to the size of its pool shouldn't allocate any more
+   * nodes, no matter how many pools with free nodes have been spliced in.
+   */
+  printf("Reusing free nodes from lists spliced in %d times... ", rounds);
+  list = list_create();
+  for (i = 0; i < n; i++) {
+    list_insert(list, &vals[i]);
+  }
+  for (i = 0; i < n / 2; i++) {
+    list_remove_head(list);
+  }
+  ok = 1;
+  for (r = 0; ok && r < rounds; r++) {
+    other = list_create();
+    for (i = 0; i < n; i++) {
+      list_insert(other, &vals[i]);
+    }
+    for (i = 0; i < n / 2; i++) {
+      list_remove_head(other);
+    }
+    pool = list_pool_size(list) + list_pool_size(other);
+    if (r % 2)
+      list_splice(list, other);
+    else
+      list_concat(list, other);
+    list_free(other);
+    for (i = 0; i < n - n / 2; i++) {
+      list_remove_head(list);
+    }
+    spare = pool - list_size(list);
+    for (i = 0; i < spare; i++) {
+      list_insert(list, &vals[i % n]);
+    }
+    ok = list_pool_size(list) == pool && list_size(list) == pool;
+    for (i = 0; i < spare; i++) {
+      list_remove_head(list);
+    }
+  }
+  check(ok && list_size(list) == n / 2);
+  list_free(list);
+
+  free(vals);
+}
+
+/*
+ * Returns 1 if every one of the `n` values in `vals` is at the same position
+ * in `list` and `ulist` (or missing from both), and 0 otherwise.
+ */
+int same_positions(struct list* list, struct ulist* ulist, int* vals, int n) {
+  int i;
+  for (i = 0; i < n; i++) {
+    if (list_position(list, &vals[i], NULL)
+        != ulist_position(ulist, &vals[i], NULL))
+      return 0;
+    if (list_position(list, &vals[i], int_ptr_cmp)
+        != ulist_position(ulist, &vals[i], int_ptr_cmp))
+      return 0;
+  }
+  return list_head(list) == ulist_head(ulist)
+      && list_isempty(list) == ulist_isempty(ulist);
+}
+
+/*
+ * Function to run tests on the unrolled linked list, by applying the same
+ * random operations to it and to a plain linked list and checking that they
+ * always agree.
+ */
+void test_ulist(int n, int ops) {
+  struct list* list;
+  struct ulist* ulist;
+  int* vals;
+  int i, op, v, ok;
+
+  printf("\n== Unrolled linked list\n");
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  list = list_create();
+  ulist = ulist_create();
+  printf("Checking that an empty list is empty... ");
+  check(ulist_isempty(ulist) && ulist_head(ulist) == NULL
+      && ulist_position(ulist, &vals[0], NULL) == -1);
+
+  printf("Inserting %d values at both ends... ", n);
+  for (i = 0; i < n; i++) {
+    if (i % 3 == 0) {
+      list_insert(list, &vals[i]);
+      ulist_insert(ulist, &vals[i]);
+    } else {
+      list_insert_end(list, &vals[i]);
+      ulist_insert_end(ulist, &vals[i]);
+    }
+  }
+  check(same_positions(list, ulist, vals, n));
+
+  printf("Reversing... ");
+  list_reverse(list);
+  ulist_reverse(ulist);
+  check(same_positions(list, ulist, vals, n));
+
+  printf("Applying %d random inserts and removes... ", ops);
+  ok = 1;
+  for (i = 0; ok && i < ops; i++) {
+    op = rand() % 6;
+    v = rand() % n;
+    if (op == 0) {
+      list_insert(list, &vals[v]);
+      ulist_insert(ulist, &vals[v]);
+    } else if (op == 1 || op == 2) {
+      list_insert_end(list, &vals[v]);
+      ulist_insert_end(ulist, &vals[v]);
+    } else if (op == 3) {
+      list_remove(list, &vals[v], NULL);
+      ulist_remove(ulist, &vals[v], NULL);
+    } else if (op == 4) {
+      list_remove_end(list);
+      ulist_remove_end(ulist);
+    } else {
+      list_remove_head(list);
+      ulist_remove_head(ulist);
+    }
+    if (i % 97 == 0)
+      ok = same_positions(list, ulist, vals, n);
+  }
+  check(ok && same_positions(list, ulist, vals, n));
+
+  printf("Emptying both lists from the end... ");
+  while (!list_isempty(list)) {
+    list_remove_end(list);
+    ulist_remove_end(ulist);
+  }
+  check(ulist_isempty(ulist));
+
+  printf("Reusing the emptied list... ");
+  ulist_insert_end(ulist, &vals[1]);
+  ulist_insert(ulist, &vals[0]);
+  ulist_reverse(ulist);
+  ulist_insert_end(ulist, &vals[2]);
+  check(ulist_position(ulist, &vals[1], NULL) == 0
+      && ulist_position(ulist, &vals[0], NULL) == 1
+      && ulist_position(ulist, &vals[2], NULL) == 2);
+
+  list_free(list);
+  ulist_free(ulist);
+  free(vals);
+}
+
+/*
+ * Returns 1 if `list` holds exactly the values `vals[first]` to
+ * `vals[last]`, in order, and 0 otherwise.  Empties `list`.
+ */
+int drain_range(struct list* list, int* vals, int first, int last) {
+  int i, ok = list_size(list) == last - first + 1;
+  for (i = first; ok && i <= last; i++) {
+    ok = list_head(list) == &vals[i];
+    list_remove_head(list);
+  }
+  return ok && list_isempty(list) && list_size(list) == 0;
+}
+
+/*
+ * Function to run tests on the list's size and tail, and on splicing lists
+ * together.
+ */
+void test_list_splice(int n) {
+  struct list* a, * b;
+  int* vals;
+  int i, ok;
+
+  printf("\n== Size, tail and splicing\n");
+  vals = malloc(3 * n * sizeof(int));
+  for (i = 0; i < 3 * n; i++) {
+    vals[i] = i;
+  }
+
+  a = list_create();
+  printf("Appending %d values in order... ", n);
+  for (i = 0; i < n; i++) {
+    list_insert_end(a, &vals[i]);
+  }
+  check(list_size(a) == n && list_position(a, &vals[n - 1], NULL) == n - 1);
+
+  printf("Appending after removing from the end and the head... ");
+  list_remove_end(a);
+  list_remove_head(a);
+  list_insert_end(a, &vals[n - 1]);
+  list_insert(a, &vals[0]);
+  check(list_size(a) == n && list_position(a, &vals[n - 1], NULL) == n - 1
+      && list_head(a) == &vals[0]);
+
+  printf("Appending after reversing twice... ");
+  list_reverse(a);
+  list_reverse(a);
+  list_remove(a, &vals[n - 1], NULL);
+  list_insert_end(a, &vals[n - 1]);
+  check(list_size(a) == n && list_position(a, &vals[n - 1], NULL) == n - 1);
+
+  printf("Concatenating two lists... ");
+  b = list_create();
+  for (i = n; i < 2 * n; i++) {
+    list_insert_end(b, &vals[i]);
+  }
+  list_concat(a, b);
+  ok = list_isempty(b) && list_size(b) == 0 && list_head(b) == NULL;
+  for (i = 2 * n; i < 3 * n; i++) {
+    list_insert_end(a, &vals[i]);
+  }
+  check(ok && list_size(a) == 3 * n);
+
+  printf("Refilling the emptied list and splicing it onto the head... ");
+  for (i = n - 1; i >= 0; i--) {
+    list_insert(b, &vals[i]);
+  }
+  for (i = 0; i < n; i++) {
+    list_remove_head(a);
+  }
+  list_splice(a, b);
+  list_free(b);
+  check(drain_range(a, vals, 0, 3 * n - 1));
+
+  printf("Splicing with empty lists... ");
+  b = list_create();
+  list_concat(a, b);
+  list_splice(b, a);
+  list_insert_end(b, &vals[1]);
+  list_concat(a, b);
+  list_insert(b, &vals[0]);
+  list_splice(a, b);
+  list_insert_end(a, &vals[2]);
+  ok = list_isempty(b);
+  list_free(b);
+  check(ok && drain_range(a, vals, 0, 2));
+
+  list_free(a);
+  free(vals);
+}
+
+/*
+ * Comparison function that orders the ints pointed to by two values.
+ */
+int int_ptr_order(void* a, void* b) {
+  return *(int*)a - *(int*)b;
+}
+
+/*
+ * Returns 1 if `list` holds `n` values in ascending order, with equal values
+ * in the order of their addresses (i.e. with equal values still in the order
+ * they were inserted, for values inserted from the start of an array), and 0
+ * otherwise.  Empties `list`.
+ */
+int drain_sorted(struct list* list, int n) {
+  int* prev = NULL, * curr;
+  int ok = list_size(list) == n;
+  while (ok && !list_isempty(list)) {
+    curr = list_head(list);
+    ok = !prev || *prev < *curr || (*prev == *curr && prev < curr);
+    prev = curr;
+    list_remove_head(list);
+  }
+  return ok && list_isempty(list);
+}
+
+/*
+ * Returns 1 if every one of the `n` values in `vals` is found at the same
+ * position in lists `a` and `b` when compared with int_ptr_order(), and the
+ * lists have the same size and head, and 0 otherwise.
+ */
+int same_order_positions(struct list* a, struct list* b, int* vals, int n) {
+  int i;
+  for (i = 0; i < n; i++) {
+    if (list_position(a, &vals[i], int_ptr_order)
+        != list_position(b, &vals[i], int_ptr_order))
+      return 0;
+  }
+  return list_size(a) == list_size(b)
+      && (list_isempty(a) || *(int*)list_head(a) == *(int*)list_head(b));
+}
+
+/*
+ * Function to run tests on sorting lists and merging sorted lists.
+ */
+void test_list_sort(int n) {
+  struct list* a, * b;
+  int* vals;
+  int i, size, ok;
+
+  printf("\n== Sorting\n");
+  vals = malloc(2 * n * sizeof(int));
+  for (i = 0; i < 2 * n; i++) {
+    vals[i] = rand() % (n / 4);
+  }
+
+  a = list_create();
+  printf("Sorting an empty list... ");
+  list_sort(a, int_ptr_order);
+  check(list_isempty(a));
+
+  printf("Sorting lists of 1 to 40 values... ");
+  ok = 1;
+  for (size = 1; ok && size <= 40; size++) {
+    for (i = 0; i < size; i++) {
+      list_insert_end(a, &vals[i]);
+    }
+    list_sort(a, int_ptr_order);
+    list_insert_end(a, &size);
+    ok = list_position(a, &size, NULL) == size;
+    list_remove_end(a);
+    ok = ok && drain_sorted(a, size);
+  }
+  check(ok);
+
+  printf("Sorting %d values... ", n);
+  for (i = 0; i < n; i++) {
+    list_insert_end(a, &vals[i]);
+  }
+  list_sort(a, int_ptr_order);
+  list_insert_end(a, &size);
+  check(list_position(a, &size, NULL) == n);
+  list_remove_end(a);
+
+  printf("Merging with a second sorted list... ");
+  b = list_create();
+  for (i = n; i < 2 * n; i++) {
+    list_insert(b, &vals[i]);
+  }
+  list_reverse(b);
+  list_sort(b, int_ptr_order);
+  list_merge_sorted(a, b, int_ptr_order);
+  ok = list_isempty(b);
+  list_insert_end(a, &size);
+  ok = ok && list_position(a, &size, NULL) == 2 * n;
+  list_remove_end(a);
+  check(ok && drain_sorted(a, 2 * n));
+
+  printf("Merging into an empty list... ");
+  for (i = 0; i < n; i++) {
+    list_insert_end(b, &vals[i]);
+  }
+  list_sort(b, int_ptr_order);
+  list_merge_sorted(a, b, int_ptr_order);
+  list_merge_sorted(a, b, int_ptr_order);
+  check(list_isempty(b) && drain_sorted(a, n));
+
+  list_free(a);
+  list_free(b);
+  free(vals);
+}
+
+/*
+ * Structure used to test the intrusive list, with its link field in the
+ * middle so ILIST_ENTRY() has a nonzero offset to undo.
+ */
+struct item {
+  int key;
+  struct ilist_link link;
+  int order;
+};
+
+/*
+ * Returns 1 if walking `list` forwards visits the items with keys `keys[0]`
+ * to `keys[n-1]`, and walking it backwards visits them in reverse, and 0
+ * otherwise.
+ */
+int ilist_has_keys(struct ilist* list, int* keys, int n) {
+  struct ilist_link* link;
+  int i = 0;
+  if (ilist_size(list) != n)
+    return 0;
+  for (link = ilist_head(list); link; link = ilist_next(list, link)) {
+    if (i >= n || ILIST_ENTRY(link, struct item, link)->key != keys[i++])
+      return 0;
+  }
+  for (link = ilist_tail(list); link; link = ilist_prev(list, link)) {
+    if (ILIST_ENTRY(link, struct item, link)->key != keys[--i])
+      return 0;
+  }
+  return i == 0;
+}
+
+/*
+ * Function to run tests on the intrusive list.
+ */
+void test_ilist(int n) {
+  struct ilist list;
+  struct item* items;
+  int* keys;
+  int i, ok;
+
+  printf("\n== Intrusive list\n");
+  items = malloc(n * sizeof(struct item));
+  keys = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    items[i].key = i;
+  }
+
+  ilist_init(&list);
+  printf("Checking that an empty list is empty... ");
+  check(ilist_isempty(&list) && ilist_head(&list) == NULL
+      && ilist_tail(&list) == NULL && ilist_remove_head(&list) == NULL
+      && ilist_remove_end(&list) == NULL);
+
+  printf("Inserting %d items at both ends... ", n);
+  for (i = 0; i < n; i++) {
+    if (i % 2)
+      ilist_insert(&list, &items[i].link);
+    else
+      ilist_insert_end(&list, &items[i].link);
+  }
+  for (i = 0; i < n; i++) {
+    keys[i] = i < n / 2 ? n - 1 - 2 * i - (n % 2) : 2 * i - n + (n % 2);
+  }
+  check(ilist_has_keys(&list, keys, n));
+
+  printf("Removing every third item from the middle... ");
+  for (i = 0; i < n; i += 3) {
+    ilist_remove(&list, &items[i].link);
+  }
+  int m = 0;
+  for (i = 0; i < n; i++) {
+    if (keys[i] % 3)
+      keys[m++] = keys[i];
+  }
+  check(ilist_has_keys(&list, keys, m));
+
+  printf("Removing from both ends... ");
+  struct ilist_link* first = ilist_remove_head(&list);
+  struct ilist_link* last = ilist_remove_end(&list);
+  ok = ILIST_ENTRY(first, struct item, link)->key == keys[0]
+      && ILIST_ENTRY(last, struct item, link)->key == keys[m - 1];
+  check(ok && ilist_has_keys(&list, keys + 1, m - 2));
+
+  printf("Emptying the list and reusing it... ");
+  while (ilist_remove_head(&list))
+    ;
+  ilist_insert_end(&list, &items[1].link);
+  ilist_insert(&list, &items[0].link);
+  ilist_insert_end(&list, &items[2].link);
+  keys[0] = 0;
+  keys[1] = 1;
+  keys[2] = 2;
+  check(ilist_has_keys(&list, keys, 3));
+
+  free(keys);
+  free(items);
+}
+
+/*
+ * Function to run tests on the skip-list index, by applying the same random
+ * operations to an indexed list and to a plain sorted list and checking that
+ * they always agree.
+ */
+void test_list_index(int n, int ops) {
+  struct list* indexed, * plain;
+  int* vals;
+  int i, op, v, ok;
+
+  printf("\n== Skip-list index\n");
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = rand() % (n / 2);
+  }
+
+  indexed = list_create();
+  plain = list_create();
+  printf("Indexing %d unsorted values... ", n);
+  for (i = 0; i < n; i++) {
+    list_insert(indexed, &vals[i]);
+    list_insert_sorted(plain, &vals[i], int_ptr_order);
+  }
+  list_index(indexed, int_ptr_order);
+  check(same_order_positions(indexed, plain, vals, n));
+
+  printf("Applying %d random sorted inserts and removes... ", ops);
+  ok = 1;
+  for (i = 0; ok && i < ops; i++) {
+    op = rand() % 5;
+    v = rand() % n;
+    if (op < 2) {
+      list_insert_sorted(indexed, &vals[v], int_ptr_order);
+      list_insert_sorted(plain, &vals[v], int_ptr_order);
+    } else if (op < 4) {
+      list_remove(indexed, &vals[v], int_ptr_order);
+      list_remove(plain, &vals[v], int_ptr_order);
+    } else {
+      list_remove_head(indexed);
+      list_remove_head(plain);
+    }
+    if (i % 97 == 0)
+      ok = same_order_positions(indexed, plain, vals, n);
+  }
+  check(ok && same_order_positions(indexed, plain, vals, n));
+
+  printf("Emptying and refilling the indexed list... ");
+  while (!list_isempty(indexed)) {
+    list_remove_head(indexed);
+    list_remove_head(plain);
+  }
+  for (i = 0; i < n; i++) {
+    list_insert_sorted(indexed, &vals[i], int_ptr_order);
+    list_insert_sorted(plain, &vals[i], int_ptr_order);
+  }
+  check(same_order_positions(indexed, plain, vals, n));
+
+  printf("Removing the index by removing by pointer... ");
+  list_remove(indexed, &vals[0], NULL);
+  list_remove(plain, &vals[0], NULL);
+  list_insert_sorted(indexed, &vals[0], int_ptr_order);
+  list_insert_sorted(plain, &vals[0], int_ptr_order);
+  check(same_order_positions(indexed, plain, vals, n));
+
+  list_free(indexed);
+  list_free(plain);
+  free(vals);
+}
+
+/*
+ * Returns 1 if `list` holds exactly the `n` values of `vals`, in order, and
+ * 0 otherwise.  Checks the tail by appending to the list and then removing
+ * the appended value again.
+ */
+int list_holds(struct list* list, int** vals, int n) {
+  int i, end;
+  if (list_size(list) != n)
+    return 0;
+  for (i = 0; i < n; i++) {
+    if (list_position(list, vals[i], NULL) != i)
+      return 0;
+  }
+  list_insert_end(list, &end);
+  i = list_position(list, &end, NULL);
+  list_remove_end(list);
+  return i == n && (n == 0 || list_head(list) == vals[0]);
+}
+
+/*
+ * Function to run tests on compacting lists.
+ */
+void test_list_compact(int n) {
+  struct list* list, * other;
+  int* vals, ** order;
+  int i, m, ok;
+
+  printf("\n== Compaction\n");
+  vals = malloc(n * sizeof(int));
+  order = malloc(n * sizeof(int*));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  list = list_create();
+  printf("Compacting an empty list... ");
+  list_compact(list);
+  check(list_holds(list, order, 0));
+
+  printf("Compacting a list scattered by inserts and removes... ");
+  for (i = 0; i < n; i++) {
+    list_insert(list, &vals[i]);
+  }
+  for (i = 0; i < n; i += 2) {
+    list_remove(list, &vals[i], NULL);
+  }
+  for (i = 0; i < n; i += 2) {
+    list_insert_end(list, &vals[i]);
+  }
+  for (m = 0, i = n - 1; i >= 0; i--) {
+    if (i % 2)
+      order[m++] = &vals[i];
+  }
+  for (i = 0; i < n; i += 2) {
+    order[m++] = &vals[i];
+  }
+  list_compact(list);
+  check(list_holds(list, order, n));
+
+  printf("Inserting and removing after compacting... ");
+  list_remove_head(list);
+  list_insert(list, order[0]);
+  list_remove_end(list);
+  list_insert_end(list, order[n - 1]);
+  check(list_holds(list, order, n));
+
+  printf("Compacting in steps while the list changes... ");
+  list_reverse(list);
+  for (i = 0; i < n / 2; i++) {
+    int* tmp = order[i];
+    order[i] = order[n - 1 - i];
+    order[n - 1 - i] = tmp;
+  }
+  for (i = 0; !list_compact_step(list, 37); i++) {
+    if (i % 5 == 0) {
+      /*
+       * Rotate the list by one.
+       */
+      int* first = order[0];
+      list_remove_head(list);
+      list_insert_end(list, first);
+      memmove(order, order + 1, (n - 1) * sizeof(int*));
+      order[n - 1] = first;
+    }
+  }
+  check(list_holds(list, order, n));
+
+  printf("Compacting an indexed list in steps... ");
+  list_index(list, int_ptr_order);
+  for (i = 0; i < n; i++) {
+    order[i] = &vals[i];
+  }
+  while (!list_compact_step(list, 100))
+    ;
+  list_remove(list, &vals[n / 2], int_ptr_order);
+  list_insert_sorted(list, &vals[n / 2], int_ptr_order);
+  ok = 1;
+  for (i = 0; ok && i < n; i++) {
+    ok = list_position(list, &vals[i], int_ptr_order) == i;
+  }
+  check(ok && list_holds(list, order, n));
+
+  printf("Splicing a list that is partly compacted... ");
+  other = list_create();
+  for (i = n - 1; i >= 0; i--) {
+    list_insert(other, &vals[i]);
+    list_remove_head(list);
+  }
+  list_compact_step(other, n / 2);
+  list_compact_step(list, 1);
+  list_concat(list, other);
+  list_free(other);
+  list_compact(list);
+  check(list_holds(list, order, n));
+
+  list_free(list);
+  free(order);
+  free(vals);
+}
+
+int main(int argc, char** argv) {
+  test_list_pool(1000, 10);
+  test_ulist(500, 5000);
+  test_list_splice(1000);
+  test_list_sort(10000);
+  test_ilist(1001);
+  test_list_index(2000, 20000);
+  test_list_compact(1000);
+  return 0;
+}
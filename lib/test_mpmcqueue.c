@@ -0,0 +1,184 @@
+/*
+ * This is a small program to test the multi-producer, multi-consumer queue
+ * implementation.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "mpmcqueue.h"
+
+#define NUM_PRODUCERS 4
+#define NUM_CONSUMERS 4
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Structure holding the work for one producer or consumer thread.  Producers
+ * enqueue `vals[0]` to `vals[n-1]` in order; consumers dequeue `n` values and
+ * count each one in `seen`, which is indexed from `base`.  Each consumer also
+ * checks that the values from any one producer arrive in the order they were
+ * enqueued, tracking the last value from each producer in `last` and setting
+ * `ok` to 0 if not.  Both sides use the try_ functions if `try` is set, and
+ * the blocking ones otherwise.
+ */
+struct worker {
+  struct mpmcqueue* queue;
+  int* vals;
+  int n;
+  int try;
+  int* base;
+  int* seen;
+  int per_producer;
+  int last[NUM_PRODUCERS];
+  int ok;
+};
+
+void* produce(void* arg) {
+  struct worker* w = arg;
+  int i;
+  for (i = 0; i < w->n; i++) {
+    if (w->try) {
+      while (!mpmcqueue_try_enqueue(w->queue, &w->vals[i]))
+        sched_yield();
+    } else {
+      mpmcqueue_enqueue(w->queue, &w->vals[i]);
+    }
+  }
+  return NULL;
+}
+
+void* consume(void* arg) {
+  struct worker* w = arg;
+  int i, p;
+  w->ok = 1;
+  for (p = 0; p < NUM_PRODUCERS; p++) {
+    w->last[p] = -1;
+  }
+  for (i = 0; i < w->n; i++) {
+    void* v;
+    if (w->try) {
+      while (!mpmcqueue_try_dequeue(w->queue, &v))
+        sched_yield();
+    } else {
+      v = mpmcqueue_dequeue(w->queue);
+    }
+    int idx = (int*)v - w->base;
+    p = idx / w->per_producer;
+    w->ok = w->ok && idx > w->last[p];
+    w->last[p] = idx;
+    __atomic_fetch_add(&w->seen[idx], 1, __ATOMIC_RELAXED);
+  }
+  return NULL;
+}
+
+/*
+ * Passes `n` values from each of NUM_PRODUCERS threads to NUM_CONSUMERS
+ * threads through an MPMC queue with capacity `capacity`, and returns 1 if
+ * every value arrived exactly once.
+ */
+int run_workers(int n, int capacity, int try) {
+  struct worker workers[NUM_PRODUCERS + NUM_CONSUMERS];
+  pthread_t threads[NUM_PRODUCERS + NUM_CONSUMERS];
+  struct mpmcqueue* queue = mpmcqueue_create(capacity);
+  int total = NUM_PRODUCERS * n;
+  int* vals = malloc(total * sizeof(int));
+  int* seen = calloc(total, sizeof(int));
+  int i, ok = 1;
+
+  for (i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; i++) {
+    int producer = i < NUM_PRODUCERS;
+    workers[i].queue = queue;
+    workers[i].vals = vals + (producer ? i * n : 0);
+    workers[i].n = producer ? n : total / NUM_CONSUMERS;
+    workers[i].try = try;
+    workers[i].base = vals;
+    workers[i].seen = seen;
+    workers[i].per_producer = n;
+    pthread_create(&threads[i], NULL, producer ? produce : consume,
+      &workers[i]);
+  }
+  for (i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; i++) {
+    pthread_join(threads[i], NULL);
+    ok = ok && (i < NUM_PRODUCERS || workers[i].ok);
+  }
+  for (i = 0; ok && i < total; i++) {
+    ok = seen[i] == 1;
+  }
+  ok = ok && mpmcqueue_isempty(queue);
+
+  mpmcqueue_free(queue);
+  free(seen);
+  free(vals);
+  return ok;
+}
+
+/*
+ * Function to run tests on the MPMC queue, passing `n` values from each
+ * producer thread.
+ */
+void test_mpmcqueue(int n) {
+  struct mpmcqueue* queue;
+  int vals[16];
+  void* val;
+  int i, ok;
+
+  printf("== MPMC queue\n");
+  queue = mpmcqueue_create(5);
+  printf("Checking that the capacity is rounded up to a power of 2... ");
+  check(mpmcqueue_capacity(queue) == 8);
+
+  printf("Checking that a new queue is empty... ");
+  check(mpmcqueue_isempty(queue) && !mpmcqueue_try_dequeue(queue, &val));
+
+  printf("Filling the queue until it is full... ");
+  ok = 1;
+  for (i = 0; ok && i < 8; i++) {
+    ok = mpmcqueue_try_enqueue(queue, &vals[i]);
+  }
+  check(ok && !mpmcqueue_try_enqueue(queue, &vals[8]));
+
+  printf("Timing out on a full queue... ");
+  check(!mpmcqueue_enqueue_timeout(queue, &vals[8], 20));
+
+  printf("Dequeueing and enqueueing around the end of the ring... ");
+  for (i = 0; ok && i < 8; i++) {
+    ok = mpmcqueue_try_dequeue(queue, &val) && val == &vals[i]
+      && mpmcqueue_enqueue_timeout(queue, &vals[8 + i], 20);
+  }
+  for (i = 8; ok && i < 16; i++) {
+    ok = mpmcqueue_dequeue(queue) == &vals[i];
+  }
+  check(ok && mpmcqueue_isempty(queue));
+
+  printf("Timing out on an empty queue... ");
+  check(!mpmcqueue_dequeue_timeout(queue, &val, 20));
+  mpmcqueue_free(queue);
+
+  printf("Passing %d values each between %d producers and %d consumers... ",
+    n, NUM_PRODUCERS, NUM_CONSUMERS);
+  check(run_workers(n, 64, 1));
+
+  printf("Doing the same with blocking enqueues and dequeues... ");
+  check(run_workers(n, 64, 0));
+
+  printf("Doing the same through a queue of 2 slots... ");
+  check(run_workers(n / 10, 2, 0));
+}
+
+int main(int argc, char** argv) {
+  test_mpmcqueue(100000);
+  return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * This is a small program to test the single-producer, single-consumer queue
+ * implementation.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "spscqueue.h"
+
+#define BATCH 64
+
+/*
+ * Prints OK if `cond` is true and FAILED otherwise.
+ */
+void check(int cond) {
+  if (cond)
+    printf("OK\n");
+  else
+    printf("FAILED\n");
+}
+
+/*
+ * Structure holding the work for the producer and consumer threads: pass
+ * `vals[0]` to `vals[n-1]` through `queue`, in batches if `batch` is set.
+ * The consumer sets `ok` to whether it got them all in order.
+ */
+struct pipeline {
+  struct spscqueue* queue;
+  int* vals;
+  int n;
+  int batch;
+  int ok;
+};
+
+void* produce(void* arg) {
+  struct pipeline* p = arg;
+  void* batch[BATCH];
+  int i = 0, j, k;
+  while (i < p->n) {
+    if (p->batch) {
+      for (k = 0; k < BATCH && i + k < p->n; k++) {
+        batch[k] = &p->vals[i + k];
+      }
+      for (j = 0; j < k; j += spscqueue_enqueue_n(p->queue, batch + j, k - j))
+        sched_yield();
+      i += k;
+    } else {
+      while (!spscqueue_enqueue(p->queue, &p->vals[i]))
+        sched_yield();
+      i++;
+    }
+  }
+  return NULL;
+}
+
+void* consume(void* arg) {
+  struct pipeline* p = arg;
+  void* batch[BATCH];
+  int i = 0, k, j;
+  p->ok = 1;
+  while (i < p->n) {
+    if (p->batch) {
+      k = spscqueue_dequeue_n(p->queue, batch, BATCH);
+      for (j = 0; j < k; j++, i++) {
+        p->ok = p->ok && batch[j] == &p->vals[i];
+      }
+    } else {
+      int* val = spscqueue_dequeue(p->queue);
+      if (val) {
+        p->ok = p->ok && val == &p->vals[i++];
+      }
+      k = val != NULL;
+    }
+    if (!k)
+      sched_yield();
+  }
+  return NULL;
+}
+
+/*
+ * Passes `n` values from a producer thread to a consumer thread through an
+ * SPSC queue with capacity `capacity`, and returns 1 if they all arrived in
+ * order.
+ */
+int run_pipeline(int* vals, int n, int capacity, int batch) {
+  struct pipeline p = { spscqueue_create(capacity), vals, n, batch, 0 };
+  pthread_t producer, consumer;
+  pthread_create(&producer, NULL, produce, &p);
+  pthread_create(&consumer, NULL, consume, &p);
+  pthread_join(producer, NULL);
+  pthread_join(consumer, NULL);
+  p.ok = p.ok && spscqueue_isempty(p.queue);
+  spscqueue_free(p.queue);
+  return p.ok;
+}
+
+/*
+ * Function to run tests on the SPSC queue, passing `n` values through it.
+ */
+void test_spscqueue(int n) {
+  struct spscqueue* queue;
+  void* out[BATCH];
+  void* in[BATCH];
+  int* vals;
+  int i, j, ok;
+
+  printf("== SPSC queue\n");
+  vals = malloc(n * sizeof(int));
+  for (i = 0; i < n; i++) {
+    vals[i] = i;
+  }
+
+  queue = spscqueue_create(10);
+  printf("Checking that the capacity is rounded up to a power of 2... ");
+  check(spscqueue_capacity(queue) == 16);
+
+  printf("Checking that a new queue is empty... ");
+  check(spscqueue_isempty(queue) && spscqueue_front(queue) == NULL
+      && spscqueue_dequeue(queue) == NULL
+      && spscqueue_dequeue_n(queue, out, BATCH) == 0);
+
+  printf("Filling the queue until it is full... ");
+  ok = 1;
+  for (i = 0; ok && i < 16; i++) {
+    ok = spscqueue_enqueue(queue, &vals[i]);
+  }
+  check(ok && !spscqueue_enqueue(queue, &vals[16])
+      && spscqueue_front(queue) == &vals[0]);
+
+  printf("Enqueueing and dequeueing around the end of the ring... ");
+  for (i = 0; ok && i < 100; i++) {
+    ok = spscqueue_dequeue(queue) == &vals[i]
+      && spscqueue_enqueue(queue, &vals[i + 16]);
+  }
+  check(ok && !spscqueue_enqueue(queue, &vals[0]));
+
+  printf("Dequeueing in batches... ");
+  ok = spscqueue_dequeue_n(queue, out, 5) == 5;
+  for (j = 0; ok && j < 5; j++) {
+    ok = out[j] == &vals[100 + j];
+  }
+  ok = ok && spscqueue_dequeue_n(queue, out, BATCH) == 11;
+  for (j = 0; ok && j < 11; j++) {
+    ok = out[j] == &vals[105 + j];
+  }
+  check(ok && spscqueue_isempty(queue));
+
+  printf("Enqueueing in batches... ");
+  for (j = 0; j < BATCH; j++) {
+    in[j] = &vals[j];
+  }
+  ok = spscqueue_enqueue_n(queue, in, 7) == 7
+    && spscqueue_enqueue_n(queue, in + 7, BATCH) == 9
+    && spscqueue_enqueue_n(queue, in, BATCH) == 0;
+  for (j = 0; ok && j < 16; j++) {
+    ok = spscqueue_dequeue(queue) == &vals[j];
+  }
+  check(ok && spscqueue_isempty(queue));
+  spscqueue_free(queue);
+
+  printf("Passing %d values between two threads... ", n);
+  check(run_pipeline(vals, n, 1024, 0));
+
+  printf("Passing %d values between two threads in batches... ", n);
+  check(run_pipeline(vals, n, 1024, 1));
+
+  free(vals);
+}
+
+int main(int argc, char** argv) {
+  test_spscqueue(1000000);
+  return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * This file contains the definition of the interface for an unrolled linked
+ * list.  It supports the same operations as the linked list in list.h.  You
+ * can find descriptions of the unrolled linked list functions, including
+ * their parameters and their return values, in ulist.c.
+ */
+
+#ifndef __ULIST_H
+#define __ULIST_H
+
+/*
+ * Structure used to represent an unrolled linked list.
+ */
+struct ulist;
+
+/*
+ * Unrolled linked list interface function prototypes.  Refer to ulist.c for
+ * documentation about each of these functions.
+ */
+struct ulist* ulist_create();
+void ulist_free(struct ulist* list);
+void ulist_insert(struct ulist* list, void* val);
+void ulist_insert_end(struct ulist* list, void* val);
+void ulist_remove(struct ulist* list, void* val, int (*cmp)(void* a, void* b));
+void ulist_remove_end(struct ulist* list);
+int ulist_position(struct ulist* list, void* val,
+    int (*cmp)(void* a, void* b));
+void ulist_reverse(struct ulist* list);
+int ulist_isempty(struct ulist* list);
+void* ulist_head(struct ulist* list);
+void ulist_remove_head(struct ulist* list);
+
+#endif